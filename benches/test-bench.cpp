@@ -1,13 +1,36 @@
 #define ANKERL_NANOBENCH_IMPLEMENT
 #include <nanobench.h>
+#include <tinymt/counter_registry.h>
+#include <tinymt/parallel_fill.h>
+#include <tinymt/population.h>
+#include <tinymt/thread_engine_pool.h>
 #include <tinymt/tinymt.h>
 
+#include <algorithm>
 #include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
 
 using namespace std;
 using namespace ankerl::nanobench;
 using namespace tinymt;
 
+// Table of the default parameter set of TinyMT32 for tinymt32_shared_dc.
+struct default_params {
+  static const tinymt32_dc::param_type& get(size_t) {
+    static const tinymt32_dc::param_type param = {
+        tinymt::detail::tinymt32_default_param_mat1,
+        tinymt::detail::tinymt32_default_param_mat2,
+        tinymt::detail::tinymt32_default_param_tmat};
+    return param;
+  }
+};
+
 #define bench_init(bench, rng, name) \
   do {                               \
     bench.run(name, [&]() {          \
@@ -16,6 +39,28 @@ using namespace tinymt;
     });                              \
   } while (false)
 
+template <typename Rng>
+void bench_init_many(Bench& bench, const Rng& rng, const char* name,
+                     size_t n) {
+  vector<Rng> r(n, rng);
+  vector<typename Rng::result_type> seeds(n);
+  for (size_t i = 0; i < n; i++) {
+    seeds[i] = static_cast<typename Rng::result_type>(i);
+  }
+  const string suffix = " x" + to_string(n);
+  bench.batch(n).run(name + string(" seed") + suffix, [&]() {
+    for (size_t i = 0; i < n; i++) {
+      r[i].seed(seeds[i]);
+    }
+    doNotOptimizeAway(r.data());
+  });
+  bench.run(name + string(" seed_many") + suffix, [&]() {
+    Rng::seed_many(r.data(), seeds.data(), n);
+    doNotOptimizeAway(r.data());
+  });
+  bench.batch(1);
+}
+
 template <typename Rng>
 void bench_gen_raw(Bench& bench, const Rng& rng, const char* name) {
   Rng r(rng);
@@ -25,6 +70,38 @@ void bench_gen_raw(Bench& bench, const Rng& rng, const char* name) {
   });
 }
 
+template <typename Rng>
+void bench_gen_bounded(Bench& bench, const Rng& rng, const char* name) {
+  Rng r(rng);
+  auto dist = uniform_int_distribution<uint32_t>(0, 999);
+  bench.run(name, [&]() {
+    auto x = dist(r);
+    doNotOptimizeAway(x);
+  });
+}
+
+template <typename Rng>
+void bench_gen_bounded_lemire(Bench& bench, const Rng& rng, const char* name) {
+  Rng r(rng);
+  auto dist = uniform_int<uint32_t>(0, 999);
+  bench.run(name, [&]() {
+    auto x = dist(r);
+    doNotOptimizeAway(x);
+  });
+}
+
+template <typename Rng>
+void bench_gen_bounded_bulk(Bench& bench, const Rng& rng, const char* name) {
+  Rng r(rng);
+  auto dist = uniform_int<uint32_t>(0, 999);
+  vector<uint32_t> x(1000);
+  bench.batch(x.size()).run(name, [&]() {
+    dist.generate(x.begin(), x.end(), r);
+    doNotOptimizeAway(x.data());
+  });
+  bench.batch(1);
+}
+
 template <typename Rng>
 void bench_gen_double(Bench& bench, const Rng& rng, const char* name) {
   Rng r(rng);
@@ -35,16 +112,393 @@ void bench_gen_double(Bench& bench, const Rng& rng, const char* name) {
   });
 }
 
+template <typename Rng>
+void bench_gen_32double(Bench& bench, const Rng& rng, const char* name) {
+  Rng r(rng);
+  bench.run(name, [&]() {
+    auto x = r.generate_32double();
+    doNotOptimizeAway(x);
+  });
+}
+
+template <typename Rng>
+void bench_gen_double01(Bench& bench, const Rng& rng, const char* name) {
+  Rng r(rng);
+  bench.run(name, [&]() {
+    auto x = r.generate_double01();
+    doNotOptimizeAway(x);
+  });
+}
+
+template <typename Rng>
+void bench_gen_float01(Bench& bench, const Rng& rng, const char* name) {
+  Rng r(rng);
+  bench.run(name, [&]() {
+    auto x = r.generate_float01();
+    doNotOptimizeAway(x);
+  });
+}
+
 template <typename Rng>
 void bench_gen_gauss(Bench& bench, const Rng& rng, const char* name) {
   Rng r(rng);
-  auto dist = normal_distribution<>();
+  auto dist = std::normal_distribution<>();
+  bench.run(name, [&]() {
+    auto x = dist(r);
+    doNotOptimizeAway(x);
+  });
+}
+
+template <typename Rng>
+void bench_gen_gauss_ziggurat(Bench& bench, const Rng& rng, const char* name) {
+  Rng r(rng);
+  auto dist = tinymt::normal_distribution<>();
+  bench.run(name, [&]() {
+    auto x = dist(r);
+    doNotOptimizeAway(x);
+  });
+}
+
+template <typename Rng>
+void bench_fill_normal(Bench& bench, const Rng& rng, const char* name) {
+  Rng r(rng);
+  vector<double> v(1000);
+  bench.batch(v.size()).run(name, [&]() {
+    fill_normal(v.data(), v.size(), r);
+    doNotOptimizeAway(v.data());
+  });
+  bench.batch(1);
+}
+
+template <typename Rng>
+void bench_gen_bernoulli(Bench& bench, const Rng& rng, double p,
+                         const char* name) {
+  Rng r(rng);
+  auto dist = std::bernoulli_distribution(p);
   bench.run(name, [&]() {
     auto x = dist(r);
     doNotOptimizeAway(x);
   });
 }
 
+template <typename Rng>
+void bench_gen_bernoulli_bits(Bench& bench, const Rng& rng, double p,
+                              const char* name) {
+  Rng r(rng);
+  auto dist = tinymt::bernoulli_distribution(p);
+  bench.run(name, [&]() {
+    auto x = dist(r);
+    doNotOptimizeAway(x);
+  });
+}
+
+template <typename Rng>
+void bench_fill_mask(Bench& bench, const Rng& rng, double p, const char* name) {
+  Rng r(rng);
+  const size_t n = 1 << 16;
+  vector<uint64_t> v(n / 64);
+  bench.batch(n).unit("bit").run(name, [&]() {
+    fill_mask(v.data(), n, r, p);
+    doNotOptimizeAway(v.data());
+  });
+  bench.batch(1).unit("op");
+}
+
+template <typename Rng>
+void bench_serialize(Bench& bench, const Rng& rng, const char* name) {
+  Rng r(rng);
+  const string prefix(name);
+
+  ostringstream os;
+  bench.run(prefix + " operator<<", [&]() {
+    os.str("");
+    os << r;
+    doNotOptimizeAway(os);
+  });
+
+  istringstream is;
+  const string text = os.str();
+  bench.run(prefix + " operator>>", [&]() {
+    is.clear();
+    is.str(text);
+    is >> r;
+    doNotOptimizeAway(r);
+  });
+
+  const size_t max_chars = Rng::max_chars;
+  vector<char> chars(max_chars);
+  bench.run(prefix + " to_chars", [&]() {
+    char* p = r.to_chars(chars.data(), chars.data() + chars.size());
+    doNotOptimizeAway(p);
+  });
+
+  bench.run(prefix + " from_chars", [&]() {
+    const char* p = r.from_chars(text.data(), text.data() + text.size());
+    doNotOptimizeAway(p);
+  });
+
+  const size_t size = Rng::serialized_size;
+  vector<unsigned char> bytes(size);
+  bench.run(prefix + " save", [&]() {
+    r.save(bytes.data());
+    doNotOptimizeAway(bytes.data());
+  });
+
+  bench.run(prefix + " load", [&]() {
+    r.load(bytes.data());
+    doNotOptimizeAway(r);
+  });
+}
+
+template <typename Rng>
+void bench_population(Bench& bench, const Rng& rng, const char* name) {
+  const size_t n = 1 << 20;
+  const char* const file = "bench-population.bin";
+  const vector<Rng> engines(n, rng);
+  const string prefix(name);
+
+  bench.batch(n).run(prefix + " population write", [&]() {
+    ofstream os(file, ios::binary);
+    population_snapshot<Rng>::write(os, engines.data(), n);
+  });
+
+  population_snapshot<Rng> snapshot(file);
+  bench.run(prefix + " population verify", [&]() {
+    bool ok = snapshot.verify();
+    doNotOptimizeAway(ok);
+  });
+
+  // Random access to the mapped file.
+  size_t i = 0;
+  bench.batch(1).run(prefix + " population restore", [&]() {
+    Rng r = snapshot[i];
+    i = (i + 40503) & (n - 1);
+    doNotOptimizeAway(r);
+  });
+
+  remove(file);
+}
+
+template <typename Rng>
+void bench_fill_bytes(Bench& bench, const Rng& rng, const char* name) {
+  Rng r(rng);
+  vector<typename Rng::result_type> v(1 << 16);
+  // Only the significant bytes count.
+  const size_t bytes = v.size() * (Rng::word_size / 8);
+  bench.batch(bytes).unit("byte").run(name, [&]() {
+    r.generate(v.begin(), v.end());
+    doNotOptimizeAway(v.data());
+  });
+  bench.batch(1).unit("op");
+}
+
+template <size_t Lanes>
+void bench_fill_bytes_array(Bench& bench, const char* name) {
+  tinymt32_dc_array<Lanes> r({tinymt::detail::tinymt32_default_param_mat1,
+                              tinymt::detail::tinymt32_default_param_mat2,
+                              tinymt::detail::tinymt32_default_param_tmat});
+  vector<uint32_t> v(1 << 16);
+  const size_t bytes = v.size() * sizeof(uint32_t);
+  bench.batch(bytes).unit("byte").run(name, [&]() {
+    r.fill(v.data(), v.size());
+    doNotOptimizeAway(v.data());
+  });
+  bench.batch(1).unit("op");
+}
+
+template <typename Rng>
+void bench_parallel_fill(Bench& bench, const Rng& rng, size_t threads,
+                         const char* name) {
+  Rng r(rng);
+  vector<typename Rng::result_type> v(1 << 24);
+  const size_t bytes = v.size() * (Rng::word_size / 8);
+  bench.batch(bytes).unit("byte").run(name, [&]() {
+    parallel_fill(v.data(), v.data() + v.size(), r, threads);
+    doNotOptimizeAway(v.data());
+  });
+  bench.batch(1).unit("op");
+}
+
+template <typename Rng>
+void bench_fill_bytes_std(Bench& bench, const Rng& rng, const char* name) {
+  Rng r(rng);
+  vector<typename Rng::result_type> v(1 << 16);
+  const size_t bytes = v.size() * (Rng::word_size / 8);
+  bench.batch(bytes).unit("byte").run(name, [&]() {
+    generate(v.begin(), v.end(), ref(r));
+    doNotOptimizeAway(v.data());
+  });
+  bench.batch(1).unit("op");
+}
+
+template <typename T, typename Rng>
+void bench_fill_uniform(Bench& bench, const Rng& rng, const char* name) {
+  Rng r(rng);
+  vector<T> v(1 << 20);
+  bench.batch(v.size()).run(name, [&]() {
+    fill_uniform(v.data(), v.size(), r);
+    doNotOptimizeAway(v.data());
+  });
+  bench.batch(1);
+}
+
+template <typename Rng>
+void bench_fill_uniform_std(Bench& bench, const Rng& rng, const char* name) {
+  Rng r(rng);
+  vector<double> v(1 << 20);
+  uniform_real_distribution<double> dist;
+  bench.batch(v.size()).run(name, [&]() {
+    for (double& x : v) {
+      x = dist(r);
+    }
+    doNotOptimizeAway(v.data());
+  });
+  bench.batch(1);
+}
+
+template <typename Rng>
+void bench_shuffle(Bench& bench, const Rng& rng, size_t n, const char* name) {
+  Rng r(rng);
+  vector<uint32_t> v(n);
+  random_permutation(v.begin(), v.end(), r);
+  bench.batch(n).run(name, [&]() {
+    tinymt::shuffle(v.begin(), v.end(), r);
+    doNotOptimizeAway(v.data());
+  });
+  bench.batch(1);
+}
+
+template <typename Rng>
+void bench_shuffle_std(Bench& bench, const Rng& rng, size_t n,
+                       const char* name) {
+  Rng r(rng);
+  vector<uint32_t> v(n);
+  random_permutation(v.begin(), v.end(), r);
+  bench.batch(n).run(name, [&]() {
+    std::shuffle(v.begin(), v.end(), r);
+    doNotOptimizeAway(v.data());
+  });
+  bench.batch(1);
+}
+
+template <typename Rng>
+void bench_discard(Bench& bench, const Rng& rng, const char* name) {
+  const unsigned long long zs[] = {1,          1000,        1024,  // NOLINT
+                                   1000000,    1000000000,  1000000000000,
+                                   1ULL << 62};
+  for (auto z : zs) {
+    Rng r(rng);
+    char buf[64];
+    snprintf(buf, sizeof(buf), "%s discard(%llu)", name, z);
+    bench.run(buf, [&]() {
+      r.discard(z);
+      doNotOptimizeAway(r);
+    });
+  }
+  for (auto z : {1ULL, 1000ULL, 1000000ULL}) {  // NOLINT
+    Rng r(rng);
+    char buf[64];
+    snprintf(buf, sizeof(buf), "%s rewind(%llu)", name, z);
+    bench.run(buf, [&]() {
+      r.rewind(z);
+      doNotOptimizeAway(r);
+    });
+  }
+  Rng r(rng);
+  bench.run(string(name) + " step_back", [&]() {
+    r.step_back();
+    doNotOptimizeAway(r);
+  });
+  bench.run(string(name) + " advance_pow2(100)", [&]() {
+    r.advance_pow2(100);
+    doNotOptimizeAway(r);
+  });
+  bench.run(string(name) + " split(12345, 1000000)", [&]() {
+    auto r2 = r.split(12345, 1000000);
+    doNotOptimizeAway(r2);
+  });
+}
+
+// Generates `n` numbers in each of `threads` threads, with an engine for each
+// thread from `engine_for(t)`.
+template <typename EngineFor>
+void run_threads(size_t threads, size_t n, EngineFor engine_for) {
+  vector<thread> workers;
+  for (size_t t = 0; t < threads; t++) {
+    workers.emplace_back([&engine_for, t, n]() {
+      auto& r = engine_for(t);
+      uint_fast32_t x = 0;
+      for (size_t i = 0; i < n; i++) {
+        x ^= r();
+      }
+      doNotOptimizeAway(x);
+    });
+  }
+  for (auto& w : workers) {
+    w.join();
+  }
+}
+
+void bench_threads(Bench& bench, size_t threads) {
+  const size_t n = 1 << 18;
+  const string suffix = " x" + to_string(threads) + " threads";
+  bench.batch(threads * n);
+
+  thread_engine_pool<tinymt32> pool(threads);
+  bench.run("thread_engine_pool<tinymt32>" + suffix, [&]() {
+    run_threads(threads, n,
+                [&pool](size_t t) -> tinymt32& { return pool[t]; });
+  });
+
+  // Engines in adjacent memory, which may share cache lines.
+  vector<tinymt32> engines(threads);
+  bench.run("vector<tinymt32>" + suffix, [&]() {
+    run_threads(threads, n,
+                [&engines](size_t t) -> tinymt32& { return engines[t]; });
+  });
+
+  // One engine shared by all the threads.
+  struct locked_engine {
+    using result_type = tinymt32::result_type;
+    tinymt32 r;
+    mutex m;
+    result_type operator()() {
+      lock_guard<mutex> lock(m);
+      return r();
+    }
+  } shared;
+  bench.run("shared tinymt32 with mutex" + suffix, [&]() {
+    run_threads(threads, n,
+                [&shared](size_t) -> locked_engine& { return shared; });
+  });
+
+  bench.batch(1);
+}
+
+void print_footprint(const char* name, size_t bytes) {
+  printf("| %s | %zu | %.1f |\n", name, bytes,
+         static_cast<double>(bytes) * 1e6 / (1024 * 1024));
+}
+
+void print_footprints() {
+  printf("\n");
+  printf("| engine | bytes/engine | MiB for 10^6 engines |\n");
+  printf("|:-------|-------------:|---------------------:|\n");
+  print_footprint("tinymt::tinymt32", sizeof(tinymt32));
+  print_footprint("tinymt::tinymt32_dc", sizeof(tinymt32_dc));
+  print_footprint("tinymt::tinymt32_shared_dc",
+                  sizeof(tinymt32_shared_dc<default_params>));
+  print_footprint("tinymt::tinymt32_dc_array<8>",
+                  sizeof(tinymt32_dc_array<8>) / 8);
+  print_footprint("tinymt::tinymt64", sizeof(tinymt64));
+  print_footprint("tinymt::tinymt64_dc", sizeof(tinymt64_dc));
+  print_footprint("tinymt::thread_engine_pool<tinymt32>",
+                  tinymt::detail::cache_line_size);
+  print_footprint("std::mt19937", sizeof(mt19937));
+  print_footprint("std::mt19937_64", sizeof(mt19937_64));
+  printf("\n");
+}
+
 #define bench_set(b, bench_func)                                           \
   do {                                                                     \
     bench_func(b, tinymt32(), "tinymt::tinymt32");                         \
@@ -53,26 +507,142 @@ void bench_gen_gauss(Bench& bench, const Rng& rng, const char* name) {
                             tinymt::detail::tinymt32_default_param_mat2,   \
                             tinymt::detail::tinymt32_default_param_tmat}), \
                "tinymt::tinymt32_dc");                                     \
+    bench_func(b, tinymt64(), "tinymt::tinymt64");                         \
     bench_func(b, mt19937(), "std::mt19937");                              \
     bench_func(b, mt19937_64(), "std::mt19937_64");                        \
                                                                            \
   } while (false)
 
-int main() {
+// Usage: test-bench.exe [JSON output file]
+int main(int argc, char* argv[]) {
   Bench b;
   b.warmup(1000).relative(true);
 
   b.title("init");
   bench_set(b, bench_init);
+  bench_init_many(b, tinymt32(), "tinymt::tinymt32", 1000);
+  bench_init_many(b, tinymt32(), "tinymt::tinymt32", 1000000);
+  bench_init_many(b, tinymt64(), "tinymt::tinymt64", 1000);
+  bench_init_many(b, tinymt64(), "tinymt::tinymt64", 1000000);
 
   b.title("gen_raw");
   bench_set(b, bench_gen_raw);
+  bench_gen_raw(b, tinymt32_shared_dc<default_params>(0),
+                "tinymt::tinymt32_shared_dc");
+  bench_gen_raw(b, tinymt32_counted<>(), "tinymt::tinymt32_counted<>");
+  bench_gen_raw(b, tinymt32_counted<registry_counter>(),
+                "tinymt::tinymt32_counted<registry_counter>");
+  bench_gen_raw(b, buffered_engine<tinymt32>(),
+                "tinymt::buffered_engine<tinymt32>");
+  bench_gen_raw(b, buffered_engine<tinymt64>(),
+                "tinymt::buffered_engine<tinymt64>");
+
+  b.title("gen_bounded");
+  bench_set(b, bench_gen_bounded);
+  bench_gen_bounded(b, buffered_engine<tinymt32>(),
+                    "tinymt::buffered_engine<tinymt32>");
+  bench_gen_bounded_lemire(b, tinymt32(), "tinymt::tinymt32 uniform_int");
+  bench_gen_bounded_bulk(b, tinymt32(),
+                         "tinymt::tinymt32 uniform_int::generate");
 
   b.title("gen_double");
   bench_set(b, bench_gen_double);
 
+  b.title("gen_double (direct)");
+  bench_gen_32double(b, tinymt32(), "tinymt::tinymt32 generate_32double");
+  bench_gen_double01(b, tinymt64(), "tinymt::tinymt64 generate_double01");
+  bench_gen_float01(b, tinymt32(), "tinymt::tinymt32 generate_float01");
+
   b.title("gen_gauss");
   bench_set(b, bench_gen_gauss);
+  bench_gen_gauss_ziggurat(b, tinymt32(),
+                           "tinymt::tinymt32 normal_distribution");
+  bench_gen_gauss_ziggurat(b, tinymt64(),
+                           "tinymt::tinymt64 normal_distribution");
+  bench_fill_normal(b, tinymt32(), "tinymt::tinymt32 fill_normal");
+
+  b.title("bernoulli");
+  bench_gen_bernoulli(b, tinymt32(), 0.5,
+                      "tinymt::tinymt32 std::bernoulli_distribution 0.5");
+  bench_gen_bernoulli_bits(b, tinymt32(), 0.5,
+                           "tinymt::tinymt32 tinymt::bernoulli_distribution "
+                           "0.5");
+  bench_gen_bernoulli(b, tinymt32(), 0.3,
+                      "tinymt::tinymt32 std::bernoulli_distribution 0.3");
+  bench_gen_bernoulli_bits(b, tinymt32(), 0.3,
+                           "tinymt::tinymt32 tinymt::bernoulli_distribution "
+                           "0.3");
+  bench_fill_mask(b, tinymt32(), 0.5, "tinymt::tinymt32 fill_mask 0.5");
+  bench_fill_mask(b, tinymt32(), 0.3, "tinymt::tinymt32 fill_mask 0.3");
+
+  b.title("serialize");
+  bench_serialize(b, tinymt32(), "tinymt::tinymt32");
+  bench_serialize(b,
+                  tinymt32_dc({tinymt::detail::tinymt32_default_param_mat1,
+                               tinymt::detail::tinymt32_default_param_mat2,
+                               tinymt::detail::tinymt32_default_param_tmat}),
+                  "tinymt::tinymt32_dc");
+  bench_serialize(b, tinymt64(), "tinymt::tinymt64");
+  bench_population(b, tinymt32(), "tinymt::tinymt32");
+  bench_population(b,
+                   tinymt32_dc({tinymt::detail::tinymt32_default_param_mat1,
+                                tinymt::detail::tinymt32_default_param_mat2,
+                                tinymt::detail::tinymt32_default_param_tmat}),
+                   "tinymt::tinymt32_dc");
+
+  b.title("fill (throughput)");
+  bench_fill_bytes(b, tinymt32(), "tinymt::tinymt32 generate");
+  bench_fill_bytes(b,
+                   tinymt32_dc({tinymt::detail::tinymt32_default_param_mat1,
+                                tinymt::detail::tinymt32_default_param_mat2,
+                                tinymt::detail::tinymt32_default_param_tmat}),
+                   "tinymt::tinymt32_dc generate");
+  bench_fill_bytes(b, tinymt64(), "tinymt::tinymt64 generate");
+  bench_fill_bytes_array<8>(b, "tinymt::tinymt32_dc_array<8> fill");
+  bench_fill_bytes_array<16>(b, "tinymt::tinymt32_dc_array<16> fill");
+  bench_parallel_fill(b, tinymt32(), 1, "tinymt::tinymt32 parallel_fill 1");
+  bench_parallel_fill(b, tinymt32(), 0, "tinymt::tinymt32 parallel_fill");
+  bench_fill_bytes_std(b, mt19937(), "std::mt19937 std::generate");
+  bench_fill_bytes_std(b, mt19937_64(), "std::mt19937_64 std::generate");
+
+  b.title("fill_uniform");
+  bench_fill_uniform<float>(b, tinymt32(), "tinymt::tinymt32 float");
+  bench_fill_uniform<double>(b, tinymt32(), "tinymt::tinymt32 double");
+  bench_fill_uniform<double>(b, tinymt64(), "tinymt::tinymt64 double");
+  bench_fill_uniform_std(b, mt19937_64(),
+                         "std::mt19937_64 std::uniform_real_distribution");
+
+  b.title("shuffle");
+  bench_shuffle(b, tinymt32(), 1 << 10, "tinymt::shuffle 1k");
+  bench_shuffle_std(b, tinymt32(), 1 << 10, "std::shuffle 1k");
+  bench_shuffle(b, tinymt32(), 1 << 24, "tinymt::shuffle 16M");
+  bench_shuffle_std(b, tinymt32(), 1 << 24, "std::shuffle 16M");
+
+  b.title("discard");
+  bench_discard(b, tinymt32(), "tinymt::tinymt32");
+  bench_discard(b,
+                tinymt32_dc({tinymt::detail::tinymt32_default_param_mat1,
+                             tinymt::detail::tinymt32_default_param_mat2,
+                             tinymt::detail::tinymt32_default_param_tmat}),
+                "tinymt::tinymt32_dc");
+  bench_discard(b, tinymt64(), "tinymt::tinymt64");
+
+  b.title("threads");
+  b.warmup(0).epochs(3).minEpochIterations(1);
+  const size_t max_threads = max(thread::hardware_concurrency(), 1U);
+  for (size_t threads = 1;; threads *= 2) {
+    bench_threads(b, min(threads, max_threads));
+    if (threads >= max_threads) {
+      break;
+    }
+  }
+
+  print_footprints();
+
+  if (argc > 1) {
+    ofstream os(argv[1]);
+    render(templates::json(), b, os);
+  }
 
   return 0;
 }
@@ -0,0 +1,233 @@
+/*
+ * counter_registry.h (0.1.0-dev)
+ *
+ * Process-wide counts of the use of engines per thread, a part of tinymt-cpp.
+ *
+ *   https://github.com/tueda/tinymt-cpp
+ *
+ * See tinymt.h for the copyright notice and the license.
+ */
+
+#ifndef TINYMT_COUNTER_REGISTRY_H
+#define TINYMT_COUNTER_REGISTRY_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <ostream>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "tinymt.h"
+
+namespace tinymt {
+
+/**
+ * Registry that aggregates the counts of the use of engines with
+ * `registry_counter` for each thread.
+ *
+ * Each thread adds to its own slot, which occupies its own cache line, so that
+ * counting needs neither locks nor atomic read-modify-write operations. The
+ * slot of a thread is kept after the thread exits. Reading the counts while
+ * other threads are counting gives a consistent value for each count but not
+ * a snapshot of all of them at a single moment.
+ */
+class counter_registry {
+  struct alignas(64) slot {
+    std::thread::id thread;
+    std::atomic<std::uint_least64_t> draws;
+    std::atomic<std::uint_least64_t> discarded;
+    std::atomic<std::uint_least64_t> seeds;
+    std::atomic<std::uint_least64_t> filled;
+
+    slot()
+        : thread(std::this_thread::get_id()),
+          draws(0),
+          discarded(0),
+          seeds(0),
+          filled(0) {}
+  };
+
+ public:
+  /**
+   * Counts of a thread.
+   */
+  struct thread_counts {
+    /**
+     * ID of the thread.
+     */
+    std::thread::id thread;
+
+    /**
+     * Counts.
+     */
+    engine_counts counts;
+  };
+
+  /**
+   * Returns the registry for the whole process.
+   *
+   * @return registry
+   */
+  static counter_registry& global() {
+    static counter_registry registry;
+    return registry;
+  }
+
+  counter_registry(const counter_registry&) = delete;
+  counter_registry& operator=(const counter_registry&) = delete;
+
+  /**
+   * Returns the counts of each thread that has used engines, in the order of
+   * their first use.
+   *
+   * @return counts of the threads
+   */
+  std::vector<thread_counts> per_thread() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<thread_counts> v;
+    for (const auto& p : slots_) {
+      const slot& s = *p.second;
+      v.push_back({s.thread,
+                   {s.draws.load(std::memory_order_relaxed),
+                    s.discarded.load(std::memory_order_relaxed),
+                    s.seeds.load(std::memory_order_relaxed),
+                    s.filled.load(std::memory_order_relaxed)}});
+    }
+    return v;
+  }
+
+  /**
+   * Returns the counts summed over all the threads.
+   *
+   * @return total counts
+   */
+  engine_counts total() const {
+    engine_counts c = engine_counts();
+    for (const thread_counts& t : per_thread()) {
+      c.draws += t.counts.draws;
+      c.discarded = detail::saturating_add(c.discarded, t.counts.discarded);
+      c.seeds += t.counts.seeds;
+      c.filled += t.counts.filled;
+    }
+    return c;
+  }
+
+  /**
+   * Writes the counts of each thread and the total in text, one line each.
+   *
+   * @param os output stream
+   */
+  void dump(std::ostream& os) const {
+    const std::vector<thread_counts> v = per_thread();
+    engine_counts c = engine_counts();
+    for (std::size_t i = 0; i < v.size(); i++) {
+      os << "thread " << i << " (" << v[i].thread << "): ";
+      write(os, v[i].counts);
+      c.draws += v[i].counts.draws;
+      c.discarded = detail::saturating_add(c.discarded, v[i].counts.discarded);
+      c.seeds += v[i].counts.seeds;
+      c.filled += v[i].counts.filled;
+    }
+    os << "total: ";
+    write(os, c);
+  }
+
+  /**
+   * Resets the counts of all the threads to zero. Counts added by other
+   * threads at the same time may be lost.
+   */
+  void reset() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const auto& p : slots_) {
+      slot& s = *p.second;
+      s.draws.store(0, std::memory_order_relaxed);
+      s.discarded.store(0, std::memory_order_relaxed);
+      s.seeds.store(0, std::memory_order_relaxed);
+      s.filled.store(0, std::memory_order_relaxed);
+    }
+  }
+
+ private:
+  friend class registry_counter;
+
+  counter_registry() = default;
+
+  mutable std::mutex mutex_;
+  // Storage and the aligned slot in it; new of over-aligned types is not
+  // guaranteed before C++17.
+  std::vector<std::pair<std::unique_ptr<unsigned char[]>, slot*>> slots_;
+
+  // Only the owner thread writes the slot, so a relaxed load and store
+  // suffice.
+  static void add(std::atomic<std::uint_least64_t>& x, std::uint_least64_t n) {
+    x.store(x.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+  }
+
+  // For the steps skipped by jumps, which can exceed 64 bits.
+  static void add_saturated(std::atomic<std::uint_least64_t>& x,
+                            std::uint_least64_t n) {
+    x.store(detail::saturating_add(x.load(std::memory_order_relaxed), n),
+            std::memory_order_relaxed);
+  }
+
+  // The slot of the calling thread in the global registry.
+  static slot& local() {
+    static thread_local slot* s = nullptr;
+    if (!s) {
+      s = global().new_slot();
+    }
+    return *s;
+  }
+
+  slot* new_slot() {
+    std::size_t space = sizeof(slot) + alignof(slot);
+    std::unique_ptr<unsigned char[]> storage(new unsigned char[space]);
+    void* p = storage.get();
+    slot* s = new (std::align(alignof(slot), sizeof(slot), p, space)) slot();
+    std::lock_guard<std::mutex> lock(mutex_);
+    slots_.emplace_back(std::move(storage), s);
+    return s;
+  }
+
+  static void write(std::ostream& os, const engine_counts& c) {
+    os << "draws " << c.draws << ", discarded " << c.discarded << ", seeds "
+       << c.seeds << ", filled " << c.filled << '\n';
+  }
+};
+
+/**
+ * Counter policy of `tinymt_engine` that counts the use of each engine as
+ * `engine_counter` and also adds the counts to the slot of the calling thread
+ * in `counter_registry::global()`.
+ */
+class registry_counter : public engine_counter {
+ public:
+  void on_draw(std::uint_least64_t n) {
+    engine_counter::on_draw(n);
+    counter_registry::add(counter_registry::local().draws, n);
+  }
+
+  void on_discard(std::uint_least64_t n) {
+    engine_counter::on_discard(n);
+    counter_registry::add_saturated(counter_registry::local().discarded, n);
+  }
+
+  void on_seed() {
+    engine_counter::on_seed();
+    counter_registry::add(counter_registry::local().seeds, 1);
+  }
+
+  void on_fill(std::uint_least64_t n) {
+    engine_counter::on_fill(n);
+    counter_registry::add(counter_registry::local().filled, n);
+  }
+};
+
+}  // namespace tinymt
+
+#endif  // TINYMT_COUNTER_REGISTRY_H
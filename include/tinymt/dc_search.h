@@ -0,0 +1,399 @@
+/*
+ * dc_search.h (0.1.0-dev)
+ *
+ * Dynamic Creation of parameter sets for TinyMT32, a part of tinymt-cpp.
+ *
+ *   https://github.com/tueda/tinymt-cpp
+ *
+ * See tinymt.h for the copyright notice and the license.
+ */
+
+#ifndef TINYMT_DC_SEARCH_H
+#define TINYMT_DC_SEARCH_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "tinymt.h"
+
+namespace tinymt {
+
+/**
+ * Parameter set of TinyMT32 found by Dynamic Creation, with the properties
+ * reported by the reference implementation (TinyMTDC).
+ */
+struct tinymt32_dc_search_result {
+  /**
+   * ID of the parameter set.
+   */
+  std::uint_least32_t id;
+
+  /**
+   * Parameter set for `tinymt32_dc`.
+   */
+  tinymt32_dc::param_type param;
+
+  /**
+   * Characteristic polynomial of the state transition. Bit `i % 64` of
+   * `characteristic[i / 64]` holds the coefficient of x^i.
+   */
+  std::array<std::uint_least64_t, 2> characteristic;
+
+  /**
+   * Number of nonzero terms in the characteristic polynomial.
+   */
+  unsigned int weight;
+
+  /**
+   * Total dimension defect of the equidistribution, i.e., the sum of
+   * floor(127 / v) - k(v) over v = 1, ..., 32, where k(v) is the dimension of
+   * equidistribution with v-bit accuracy.
+   */
+  unsigned int delta;
+};
+
+namespace detail {
+
+/**
+ * Counter-based random number stream for the parameter search, which depends
+ * only on the seed and the ID.
+ */
+class dc_search_random {
+ public:
+  dc_search_random(std::uint_least64_t seed, std::uint_least32_t id)
+      : x_(mix(seed ^ mix(id))) {}
+
+  std::uint_least64_t operator()() {
+    // SplitMix64.
+    x_ = (x_ + 0x9e3779b97f4a7c15U) & f2_word_mask;
+    return mix(x_);
+  }
+
+  std::uint_least32_t word32() {
+    return static_cast<std::uint_least32_t>((*this)() >> 32);
+  }
+
+ private:
+  std::uint_least64_t x_;
+
+  static std::uint_least64_t mix(std::uint_least64_t z) {
+    z = ((z ^ (z >> 30)) * 0xbf58476d1ce4e5b9U) & f2_word_mask;
+    z = ((z ^ (z >> 27)) * 0x94d049bb133111ebU) & f2_word_mask;
+    return z ^ (z >> 31);
+  }
+};
+
+/**
+ * Bijective mixing of 32-bit words, which gives distinct `mat1` for distinct
+ * IDs.
+ */
+inline std::uint_least32_t dc_search_mat1(std::uint_least32_t id,
+                                          std::uint_least64_t seed) {
+  // The offset avoids mat1 = 0 for the first ID.
+  std::uint_least32_t x =
+      ((id ^ static_cast<std::uint_least32_t>(seed)) + 0x9e3779b9U) &
+      0xffffffffU;
+  x ^= x >> 16;
+  x = (x * 0x7feb352dU) & 0xffffffffU;
+  x ^= x >> 15;
+  x = (x * 0x846ca68bU) & 0xffffffffU;
+  x ^= x >> 16;
+  return x;
+}
+
+/**
+ * Returns the number of nonzero terms of the given polynomial.
+ */
+inline unsigned int dc_search_weight(const f2_polynomial& p) {
+  unsigned int weight = 0;
+  for (std::size_t i = 0; i <= tinymt_mexp; i++) {
+    if (f2_coefficient(p, i)) {
+      weight++;
+    }
+  }
+  return weight;
+}
+
+/**
+ * Dimensions of equidistribution of TinyMT32 for a fixed (mat1, mat2), as
+ * functions of tmat.
+ *
+ * The outputs are linear in the 127-bit state once the addition in the
+ * tempering is replaced by XOR, as in TinyMTDC. Each output bit is stored as a
+ * row vector over the state bits, split into the part independent of tmat and
+ * the part multiplied by tmat.
+ */
+class tinymt32_equidistribution {
+ public:
+  using impl = tinymt_engine_impl<std::uint_fast32_t, 32, 0, 0, 0, true>;
+  using row = std::array<std::uint_least64_t, 2>;
+
+  static constexpr std::size_t outputs = tinymt_mexp;
+
+  explicit tinymt32_equidistribution(const impl::param_type& param)
+      : rows_(outputs * 32), tmat_rows_(outputs) {
+    impl::status_type s;
+    s.mat1 = static_cast<std::uint_least32_t>(param.mat1);
+    s.mat2 = static_cast<std::uint_least32_t>(param.mat2);
+    s.tmat = 0;
+    for (std::size_t b = 0; b < tinymt_mexp; b++) {
+      // b-th basis vector of the state without the dropped bit of status[0].
+      s.status.fill(0);
+      if (b < 31) {
+        s.status[0] = std::uint_least32_t(1) << b;
+      } else {
+        s.status[1 + (b - 31) / 32] = std::uint_least32_t(1)
+                                      << ((b - 31) % 32);
+      }
+      for (std::size_t j = 0; j < outputs; j++) {
+        impl::next_state(s);
+        const std::uint_least64_t t1 =
+            (s.status[0] ^ (s.status[2] >> impl::sh8)) & impl::mask32;
+        const std::uint_least64_t a = s.status[3] ^ t1;
+        for (std::size_t k = 0; k < 32; k++) {
+          rows_[j * 32 + k][b / 64] |= ((a >> (31 - k)) & 1) << (b % 64);
+        }
+        tmat_rows_[j][b / 64] |= (t1 & 1) << (b % 64);
+      }
+    }
+  }
+
+  /**
+   * Returns the maximum possible k(v), i.e., floor(127 / v).
+   */
+  static std::size_t max_k(std::size_t v) { return tinymt_mexp / v; }
+
+  /**
+   * Returns k(v) for the given tmat, which depends only on the upper v bits
+   * of tmat.
+   */
+  std::size_t k(std::size_t v, std::uint_least32_t tmat) const {
+    std::array<row, tinymt_mexp> pivots;
+    std::array<bool, tinymt_mexp> has_pivot;
+    has_pivot.fill(false);
+    const std::size_t kmax = max_k(v);
+    for (std::size_t j = 0; j < kmax; j++) {
+      for (std::size_t i = 0; i < v; i++) {
+        row r = rows_[j * 32 + i];
+        if (((tmat >> (31 - i)) & 1) != 0) {
+          r[0] ^= tmat_rows_[j][0];
+          r[1] ^= tmat_rows_[j][1];
+        }
+        if (!insert(r, pivots, has_pivot)) {
+          return j;
+        }
+      }
+    }
+    return kmax;
+  }
+
+  /**
+   * Returns the total dimension defect for the given tmat.
+   */
+  unsigned int delta(std::uint_least32_t tmat) const {
+    std::size_t d = 0;
+    for (std::size_t v = 1; v <= 32; v++) {
+      d += max_k(v) - k(v, tmat);
+    }
+    return static_cast<unsigned int>(d);
+  }
+
+ private:
+  std::vector<row> rows_;
+  std::vector<row> tmat_rows_;
+
+  // Gaussian elimination step; returns false if `r` is linearly dependent on
+  // the pivots, which are indexed by their leading bits.
+  static bool insert(row r, std::array<row, tinymt_mexp>& pivots,
+                     std::array<bool, tinymt_mexp>& has_pivot) {
+    for (std::size_t w = 2; w-- > 0;) {
+      while (r[w] != 0) {
+        const std::size_t c = w * 64 + detail::highest_bit(r[w]);
+        if (!has_pivot[c]) {
+          pivots[c] = r;
+          has_pivot[c] = true;
+          return true;
+        }
+        r[0] ^= pivots[c][0];
+        r[1] ^= pivots[c][1];
+      }
+    }
+    return false;
+  }
+};
+
+/**
+ * Searches tmat with the smallest dimension defect, fixing its bits from the
+ * most significant one so that each k(v) is maximized in turn. Because k(v)
+ * depends only on the upper v bits, the defect is known when all the bits are
+ * fixed. Ties are broken at random, and the search is repeated a few times
+ * unless the defect is zero.
+ */
+inline std::uint_least32_t dc_search_tmat(const tinymt32_equidistribution& eq,
+                                          dc_search_random& rng,
+                                          unsigned int& delta) {
+  const unsigned int TRIALS = 16;
+
+  std::uint_least32_t best = 0;
+  delta = ~0U;
+  for (unsigned int trial = 0; trial < TRIALS && delta > 0; trial++) {
+    const std::uint_least32_t coin = rng.word32();
+    std::uint_least32_t tmat = 0;
+    std::size_t d = 0;
+    for (std::size_t v = 1; v <= 32 && d < delta; v++) {
+      const std::size_t kmax = tinymt32_equidistribution::max_k(v);
+      const std::uint_least32_t bit = std::uint_least32_t(1) << (32 - v);
+      tmat |= coin & bit;
+      std::size_t k = eq.k(v, tmat);
+      if (k < kmax) {
+        const std::size_t k2 = eq.k(v, tmat ^ bit);
+        if (k2 > k) {
+          tmat ^= bit;
+          k = k2;
+        }
+      }
+      d += kmax - k;
+    }
+    if (d < delta) {
+      best = tmat;
+      delta = static_cast<unsigned int>(d);
+    }
+  }
+  return best;
+}
+
+}  // namespace detail
+
+/**
+ * Finds a parameter set of TinyMT32 for the given ID by Dynamic Creation.
+ *
+ * The result depends only on `id` and `seed`. Different IDs with the same seed
+ * always give different parameter sets, because `mat1` is a bijective function
+ * of the ID; `mat2` is searched so that the period is 2^127-1, and `tmat` is
+ * searched for good equidistribution (`delta` is zero in most cases). The
+ * parameter sets are not the same as those of TinyMTDC.
+ *
+ * @param id   ID of the parameter set
+ * @param seed seed of the search
+ * @return the parameter set and its properties
+ */
+inline tinymt32_dc_search_result find_tinymt32_dc_param(
+    std::uint_least32_t id, std::uint_least64_t seed = 0) {
+  using impl = detail::tinymt32_equidistribution::impl;
+
+  // The probability of a primitive characteristic polynomial is about 1/127,
+  // so this limit is never reached in practice.
+  const unsigned long MAX_TRIALS = 1UL << 20;  // NOLINT
+  // If no tmat gives the full equidistribution, a few more mat2 are tried.
+  const unsigned int MAX_CANDIDATES = 8;
+
+  detail::dc_search_random rng(seed, id);
+  impl::status_type s;
+  s.mat1 = detail::dc_search_mat1(id, seed);
+  s.tmat = 0;
+  tinymt32_dc_search_result result;
+  result.id = id;
+  result.delta = ~0U;
+  unsigned int candidates = 0;
+  for (unsigned long i = 0; i < MAX_TRIALS; i++) {  // NOLINT
+    s.mat2 = rng.word32();
+    const detail::f2_polynomial p = impl::characteristic_polynomial(s);
+    if (!detail::f2_is_primitive(p)) {
+      continue;
+    }
+    unsigned int delta;
+    const detail::tinymt32_equidistribution eq({s.mat1, s.mat2, 0});
+    const std::uint_least32_t tmat = detail::dc_search_tmat(eq, rng, delta);
+    if (delta < result.delta) {
+      result.param.mat1 = s.mat1;
+      result.param.mat2 = s.mat2;
+      result.param.tmat = tmat;
+      result.characteristic = p.coef;
+      result.weight = detail::dc_search_weight(p);
+      result.delta = delta;
+    }
+    if (result.delta == 0 || ++candidates == MAX_CANDIDATES) {
+      return result;
+    }
+  }
+  throw std::runtime_error("tinymt: no parameter set found");  // LCOV_EXCL_LINE
+}
+
+/**
+ * Finds parameter sets of TinyMT32 for consecutive IDs by Dynamic Creation,
+ * using multiple threads.
+ *
+ * The result for each ID is the same as `find_tinymt32_dc_param(id, seed)`,
+ * independently of the number of threads.
+ *
+ * @param first_id    first ID
+ * @param count       number of parameter sets
+ * @param num_threads number of threads; 0 means
+ * `std::thread::hardware_concurrency()`
+ * @param seed        seed of the search
+ * @return the parameter sets ordered by ID
+ *
+ * @note If a thread cannot be created, the other threads search the remaining
+ * IDs.
+ */
+inline std::vector<tinymt32_dc_search_result> find_tinymt32_dc_params(
+    std::uint_least32_t first_id, std::size_t count,
+    unsigned int num_threads = 0, std::uint_least64_t seed = 0) {
+  std::vector<tinymt32_dc_search_result> results(count);
+  if (num_threads == 0) {
+    num_threads = std::thread::hardware_concurrency();
+  }
+  if (num_threads == 0) {
+    num_threads = 1;
+  }
+  if (num_threads > count) {
+    num_threads = static_cast<unsigned int>(count);
+  }
+
+  // IDs are handed out one by one, which balances the randomly varying search
+  // time among the threads.
+  std::atomic<std::size_t> next(0);
+  std::vector<std::exception_ptr> errors(num_threads);
+  auto worker = [&](unsigned int t) {
+    try {
+      for (std::size_t i; (i = next.fetch_add(1)) < count;) {
+        const auto id =
+            static_cast<std::uint_least32_t>((first_id + i) & 0xffffffffU);
+        results[i] = find_tinymt32_dc_param(id, seed);
+      }
+    } catch (...) {  // LCOV_EXCL_LINE
+      errors[t] = std::current_exception();  // LCOV_EXCL_LINE
+      next = count;                          // LCOV_EXCL_LINE
+    }
+  };
+
+  std::vector<std::thread> threads;
+  try {
+    for (unsigned int t = 1; t < num_threads; t++) {
+      threads.emplace_back(worker, t);
+    }
+  } catch (...) {  // LCOV_EXCL_LINE
+    // Continue with the threads already running.
+  }
+  if (num_threads > 0) {
+    worker(0);
+  }
+  for (auto& th : threads) {
+    th.join();
+  }
+  for (auto& e : errors) {
+    if (e) {
+      std::rethrow_exception(e);  // LCOV_EXCL_LINE
+    }
+  }
+  return results;
+}
+
+}  // namespace tinymt
+
+#endif  // TINYMT_DC_SEARCH_H
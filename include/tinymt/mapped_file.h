@@ -0,0 +1,156 @@
+/*
+ * mapped_file.h (0.1.0-dev)
+ *
+ * Read-only memory-mapped files, a part of tinymt-cpp.
+ *
+ *   https://github.com/tueda/tinymt-cpp
+ *
+ * See tinymt.h for the copyright notice and the license.
+ */
+
+#ifndef TINYMT_MAPPED_FILE_H
+#define TINYMT_MAPPED_FILE_H
+
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#define TINYMT_CPP_UNDEF_NOMINMAX
+#endif
+#include <windows.h>
+#ifdef TINYMT_CPP_UNDEF_NOMINMAX
+#undef NOMINMAX
+#undef TINYMT_CPP_UNDEF_NOMINMAX
+#endif
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace tinymt {
+
+namespace detail {
+
+/**
+ * Whole file mapped read-only into memory. Pages are loaded by the operating
+ * system only when they are touched.
+ */
+class mapped_file {
+ public:
+  mapped_file() noexcept : data_(nullptr), size_(0) {}
+
+  /**
+   * Maps the given file.
+   *
+   * @param path path to the file
+   * @throw std::runtime_error if the file cannot be mapped
+   */
+  explicit mapped_file(const std::string& path) : data_(nullptr), size_(0) {
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ,
+                              nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL,
+                              nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+      throw std::runtime_error("tinymt: cannot open " + path);
+    }
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size)) {
+      CloseHandle(file);
+      throw std::runtime_error("tinymt: cannot stat " + path);
+    }
+    size_ = static_cast<std::size_t>(size.QuadPart);
+    if (size_ > 0) {
+      HANDLE mapping =
+          CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+      if (mapping != nullptr) {
+        data_ = static_cast<const unsigned char*>(
+            MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+        CloseHandle(mapping);
+      }
+    }
+    CloseHandle(file);
+#else
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+      throw std::runtime_error("tinymt: cannot open " + path);
+    }
+    struct stat st;
+    if (::fstat(fd, &st) != 0) {
+      ::close(fd);
+      throw std::runtime_error("tinymt: cannot stat " + path);
+    }
+    size_ = static_cast<std::size_t>(st.st_size);
+    if (size_ > 0) {
+      void* p = ::mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd, 0);
+      if (p != MAP_FAILED) {
+        data_ = static_cast<const unsigned char*>(p);
+      }
+    }
+    // The mapping stays valid after closing the file.
+    ::close(fd);
+#endif
+    if (size_ > 0 && data_ == nullptr) {
+      throw std::runtime_error("tinymt: cannot map " + path);
+    }
+  }
+
+  mapped_file(const mapped_file&) = delete;
+  mapped_file& operator=(const mapped_file&) = delete;
+
+  mapped_file(mapped_file&& other) noexcept
+      : data_(other.data_), size_(other.size_) {
+    other.data_ = nullptr;
+    other.size_ = 0;
+  }
+
+  mapped_file& operator=(mapped_file&& other) noexcept {
+    if (this != &other) {
+      unmap();
+      data_ = other.data_;
+      size_ = other.size_;
+      other.data_ = nullptr;
+      other.size_ = 0;
+    }
+    return *this;
+  }
+
+  ~mapped_file() { unmap(); }
+
+  /**
+   * Returns the beginning of the mapped file, or `nullptr` for an empty file.
+   */
+  const unsigned char* data() const { return data_; }
+
+  /**
+   * Returns the size of the file in bytes.
+   */
+  std::size_t size() const { return size_; }
+
+ private:
+  const unsigned char* data_;
+  std::size_t size_;
+
+  void unmap() noexcept {
+    if (data_ != nullptr) {
+#ifdef _WIN32
+      UnmapViewOfFile(data_);
+#else
+      ::munmap(const_cast<unsigned char*>(data_), size_);
+#endif
+      data_ = nullptr;
+      size_ = 0;
+    }
+  }
+};
+
+}  // namespace detail
+
+}  // namespace tinymt
+
+#endif  // TINYMT_MAPPED_FILE_H
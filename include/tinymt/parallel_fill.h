@@ -0,0 +1,190 @@
+/*
+ * parallel_fill.h (0.1.0-dev)
+ *
+ * Multithreaded generation reproducible for any number of threads, a part of
+ * tinymt-cpp.
+ *
+ *   https://github.com/tueda/tinymt-cpp
+ *
+ * See tinymt.h for the copyright notice and the license.
+ */
+
+#ifndef TINYMT_PARALLEL_FILL_H
+#define TINYMT_PARALLEL_FILL_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <iterator>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "tinymt.h"
+
+namespace tinymt {
+
+namespace detail {
+
+/**
+ * Number of elements filled by a thread at a time in `parallel_fill()`, large
+ * enough for the jumps to the blocks to be negligible and for
+ * `generate_transform()` to use its substreams.
+ */
+constexpr std::size_t parallel_fill_block_size = std::size_t(1) << 18;
+
+/**
+ * Conversion of the outputs for `parallel_fill()`, as in the assignment.
+ */
+template <class T>
+struct parallel_fill_op {
+  template <class U>
+  T operator()(U x) const {
+    return static_cast<T>(x);
+  }
+};
+
+/**
+ * Fills `n` elements from `first` by the bulk generation of `g`.
+ */
+template <class T, class G>
+inline void parallel_fill_block(T* first, std::size_t n, G& g,
+                                std::true_type /* generate_transform */) {
+  g.generate_transform(first, n, parallel_fill_op<T>());
+}
+
+template <class RandomIt, class G>
+inline void parallel_fill_block(RandomIt first, std::size_t n, G& g,
+                                std::false_type /* generate_transform */) {
+  using difference_type =
+      typename std::iterator_traits<RandomIt>::difference_type;
+  g.generate(first, first + static_cast<difference_type>(n));
+}
+
+/**
+ * Type of the copies of the engine made by the threads of `parallel_fill()`,
+ * which do not count their use.
+ */
+template <class Engine>
+struct parallel_fill_engine {
+  using type = Engine;
+};
+
+template <class UIntType, std::size_t WordSize, UIntType Mat1, UIntType Mat2,
+          UIntType TMat, bool DoPeriodCertification, class Counter>
+struct parallel_fill_engine<tinymt_engine<
+    UIntType, WordSize, Mat1, Mat2, TMat, DoPeriodCertification, Counter>> {
+  using type = tinymt_engine<UIntType, WordSize, Mat1, Mat2, TMat,
+                             DoPeriodCertification, no_counter>;
+};
+
+/**
+ * Advances the engine past the range filled by `parallel_fill()`.
+ */
+template <class Engine>
+inline void parallel_fill_advance(Engine& engine, std::size_t n) {
+  engine.discard(n);
+}
+
+// The range counts as filled by the engine, not as discarded.
+template <class UIntType, std::size_t WordSize, UIntType Mat1, UIntType Mat2,
+          UIntType TMat, bool DoPeriodCertification, class Counter>
+inline void parallel_fill_advance(
+    tinymt_engine<UIntType, WordSize, Mat1, Mat2, TMat, DoPeriodCertification,
+                  Counter>& engine,
+    std::size_t n) {
+  using engine_type = tinymt_engine<UIntType, WordSize, Mat1, Mat2, TMat,
+                                    DoPeriodCertification, Counter>;
+  typename parallel_fill_engine<engine_type>::type e(engine);
+  e.discard(n);
+  const Counter counter = engine.counter();
+  engine = engine_type(e);
+  engine.counter() = counter;
+  engine.counter().on_fill(n);
+}
+
+}  // namespace detail
+
+/**
+ * Fills the given range with pseudo-random numbers by several threads, with
+ * the same results as successive calls of `engine()` independently of the
+ * number of threads. The engine is advanced past the range.
+ *
+ * The range is divided into blocks of a fixed size. Each thread takes the
+ * next unfilled block, makes a copy of the engine, jumps to the beginning of
+ * the block by `discard()` and fills the block by the bulk generation:
+ * `generate_transform()` for arrays given by pointers, e.g., for TinyMT32 in
+ * several substreams together by SIMD instructions, or `generate()`
+ * otherwise. A range within a single block is filled in the calling thread.
+ *
+ * The counter policy of `tinymt_engine` records the whole range as generated
+ * in bulk by the engine in the calling thread, as `fill()` does; the copies and
+ * their jumps are not counted.
+ *
+ * @param first       beginning of the range
+ * @param last        end of the range
+ * @param engine      engine whose `discard()` is fast, e.g., `tinymt32`
+ * @param num_threads maximum number of threads including the calling thread,
+ * or 0 for `std::thread::hardware_concurrency()`
+ *
+ * @note If a thread cannot be created, the other threads fill the remaining
+ * blocks.
+ */
+template <class RandomIt, class Engine>
+inline void parallel_fill(RandomIt first, RandomIt last, Engine& engine,
+                          std::size_t num_threads = 0) {
+  using value_type = typename std::iterator_traits<RandomIt>::value_type;
+  using difference_type =
+      typename std::iterator_traits<RandomIt>::difference_type;
+  using copy_type = typename detail::parallel_fill_engine<Engine>::type;
+  using use_transform = std::integral_constant<
+      bool, std::is_pointer<RandomIt>::value &&
+                detail::has_generate_transform<Engine, value_type>::value>;
+
+  const std::size_t n = static_cast<std::size_t>(last - first);
+  const std::size_t block_size = detail::parallel_fill_block_size;
+  const std::size_t blocks = (n + block_size - 1) / block_size;
+
+  if (num_threads == 0) {
+    num_threads = std::max(std::thread::hardware_concurrency(), 1U);
+  }
+  num_threads = std::min(num_threads, blocks);
+  if (num_threads <= 1) {
+    detail::parallel_fill_block(first, n, engine, use_transform());
+    return;
+  }
+
+  std::atomic<std::size_t> next(0);
+  auto work = [&]() {
+    for (;;) {
+      const std::size_t k = next.fetch_add(1);
+      if (k >= blocks) {
+        return;
+      }
+      const std::size_t offset = k * block_size;
+      copy_type e(engine);
+      e.discard(offset);
+      detail::parallel_fill_block(first + static_cast<difference_type>(offset),
+                                  std::min(block_size, n - offset), e,
+                                  use_transform());
+    }
+  };
+
+  std::vector<std::thread> threads;
+  try {
+    for (std::size_t i = 1; i < num_threads; i++) {
+      threads.emplace_back(work);
+    }
+  } catch (...) {
+    // Continue with the threads already running.
+  }
+  work();
+  for (std::thread& t : threads) {
+    t.join();
+  }
+  detail::parallel_fill_advance(engine, n);
+}
+
+}  // namespace tinymt
+
+#endif  // TINYMT_PARALLEL_FILL_H
@@ -0,0 +1,349 @@
+/*
+ * param_db.h (0.1.0-dev)
+ *
+ * Binary database of parameter sets for TinyMT32, a part of tinymt-cpp.
+ *
+ *   https://github.com/tueda/tinymt-cpp
+ *
+ * See tinymt.h for the copyright notice and the license.
+ */
+
+#ifndef TINYMT_PARAM_DB_H
+#define TINYMT_PARAM_DB_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "mapped_file.h"
+#include "tinymt.h"
+
+namespace tinymt {
+
+namespace detail {
+
+/**
+ * Parses an unsigned integer of at most 32 bits in the given base (10 or 16)
+ * without any prefix. Returns false on error.
+ */
+inline bool parse_uint32(const std::string& s, unsigned int base,
+                         std::uint_least32_t& x) {
+  if (s.empty()) {
+    return false;
+  }
+  std::uint_least64_t y = 0;
+  for (char c : s) {
+    unsigned int d;
+    if (c >= '0' && c <= '9') {
+      d = static_cast<unsigned int>(c - '0');
+    } else if (c >= 'a' && c <= 'f') {
+      d = static_cast<unsigned int>(c - 'a' + 10);
+    } else if (c >= 'A' && c <= 'F') {
+      d = static_cast<unsigned int>(c - 'A' + 10);
+    } else {
+      return false;
+    }
+    if (d >= base) {
+      return false;
+    }
+    y = y * base + d;
+    if (y > 0xffffffffU) {
+      return false;
+    }
+  }
+  x = static_cast<std::uint_least32_t>(y);
+  return true;
+}
+
+/**
+ * Parses a line of the TinyMTDC output for TinyMT32,
+ *
+ *   characteristic,type,id,mat1,mat2,tmat,weight,delta
+ *
+ * with mat1, mat2 and tmat in hexadecimal. Returns false for a blank line or a
+ * comment starting with '#'.
+ *
+ * @throw std::runtime_error if the line is malformed
+ */
+inline bool parse_tinymt32dc_line(const std::string& line,
+                                  std::uint_least32_t& id,
+                                  tinymt32_dc::param_type& param) {
+  const std::size_t begin = line.find_first_not_of(" \t\r");
+  if (begin == std::string::npos || line[begin] == '#') {
+    return false;
+  }
+  std::vector<std::string> fields;
+  std::size_t pos = begin;
+  for (;;) {
+    const std::size_t comma = line.find(',', pos);
+    fields.push_back(line.substr(pos, comma - pos));
+    if (comma == std::string::npos) {
+      break;
+    }
+    pos = comma + 1;
+  }
+  std::uint_least32_t mat1;
+  std::uint_least32_t mat2;
+  std::uint_least32_t tmat;
+  if (fields.size() < 6 || fields[1] != "32" ||
+      !parse_uint32(fields[2], 10, id) || !parse_uint32(fields[3], 16, mat1) ||
+      !parse_uint32(fields[4], 16, mat2) ||
+      !parse_uint32(fields[5], 16, tmat)) {
+    throw std::runtime_error("tinymt: malformed TinyMT32DC line: " + line);
+  }
+  param.mat1 = mat1;
+  param.mat2 = mat2;
+  param.tmat = tmat;
+  return true;
+}
+
+}  // namespace detail
+
+/**
+ * Read-only database of parameter sets for `tinymt32_dc`, stored in a binary
+ * file and memory-mapped.
+ *
+ * The file consists of a 32-byte header followed by the records for
+ * consecutive IDs, all in little-endian byte order:
+ *
+ *   offset  size  content
+ *        0     8  magic "TMT32DCP"
+ *        8     4  format version (1)
+ *       12     4  record size (12)
+ *       16     4  first ID
+ *       20     4  reserved (0)
+ *       24     8  number of records
+ *       32  12*n  records of (mat1, mat2, tmat) sorted by ID
+ *
+ * Opening a database reads only the header; a lookup reads one record
+ * directly from the mapped memory.
+ */
+class tinymt32_dc_param_db {
+ public:
+  /**
+   * Type of the parameter sets.
+   */
+  using param_type = tinymt32_dc::param_type;
+
+  /**
+   * Size of the header in bytes.
+   */
+  static constexpr std::size_t header_size = 32;
+
+  /**
+   * Size of a record in bytes.
+   */
+  static constexpr std::size_t record_size = 12;
+
+  /**
+   * Format version.
+   */
+  static constexpr std::uint_least32_t version = 1;
+
+  /**
+   * Opens a database file.
+   *
+   * @param path path to the file
+   * @throw std::runtime_error if the file cannot be mapped or is not a valid
+   * database
+   */
+  explicit tinymt32_dc_param_db(const std::string& path)
+      : file_(path), first_id_(0), size_(0) {
+    const unsigned char* p = file_.data();
+    if (file_.size() < header_size || !std::equal(p, p + 8, magic()) ||
+        detail::load_le32(p + 8) != version ||
+        detail::load_le32(p + 12) != record_size) {
+      throw std::runtime_error("tinymt: not a TinyMT32DC database: " + path);
+    }
+    first_id_ = detail::load_le32(p + 16);
+    const std::uint_least64_t count =
+        detail::load_le32(p + 24) |
+        (static_cast<std::uint_least64_t>(detail::load_le32(p + 28)) << 32);
+    if (count > 0x100000000U ||
+        count != (file_.size() - header_size) / record_size ||
+        (file_.size() - header_size) % record_size != 0) {
+      throw std::runtime_error("tinymt: broken TinyMT32DC database: " + path);
+    }
+    size_ = static_cast<std::size_t>(count);
+  }
+
+  /**
+   * Returns the first ID.
+   *
+   * @return first ID
+   */
+  std::uint_least32_t first_id() const { return first_id_; }
+
+  /**
+   * Returns the number of parameter sets.
+   *
+   * @return number of parameter sets
+   */
+  std::size_t size() const { return size_; }
+
+  /**
+   * Checks whether the database has the parameter set for the given ID.
+   *
+   * @param id ID
+   * @return `true` if the ID is in the database, `false` otherwise
+   */
+  bool contains(std::uint_least32_t id) const {
+    return index(id) < static_cast<std::uint_least64_t>(size_);
+  }
+
+  /**
+   * Returns the parameter set for the given ID, which must be in the database.
+   *
+   * @param id ID
+   * @return parameter set
+   */
+  param_type operator[](std::uint_least32_t id) const {
+    const unsigned char* p =
+        file_.data() + header_size +
+        static_cast<std::size_t>(index(id)) * record_size;
+    return param_type{detail::load_le32(p), detail::load_le32(p + 4),
+                      detail::load_le32(p + 8)};
+  }
+
+  /**
+   * Returns the parameter set for the given ID.
+   *
+   * @param id ID
+   * @return parameter set
+   * @throw std::out_of_range if the ID is not in the database
+   */
+  param_type at(std::uint_least32_t id) const {
+    if (!contains(id)) {
+      throw std::out_of_range("tinymt: ID not in the database");
+    }
+    return (*this)[id];
+  }
+
+  /**
+   * Writes a database of parameter sets for consecutive IDs.
+   *
+   * @param os       output stream, which should be opened in binary mode
+   * @param first_id ID of the first parameter set
+   * @param params   pointer to the parameter sets
+   * @param count    number of parameter sets
+   */
+  static void write(std::ostream& os, std::uint_least32_t first_id,
+                    const param_type* params, std::size_t count) {
+    unsigned char header[header_size] = {};
+    std::copy(magic(), magic() + 8, header);
+    detail::store_le32(header + 8, version);
+    detail::store_le32(header + 12, record_size);
+    detail::store_le32(header + 16, first_id);
+    const auto n = static_cast<std::uint_least64_t>(count);
+    detail::store_le32(header + 24,
+                       static_cast<std::uint_least32_t>(n & 0xffffffffU));
+    detail::store_le32(header + 28, static_cast<std::uint_least32_t>(n >> 32));
+    os.write(reinterpret_cast<const char*>(header),
+             static_cast<std::streamsize>(header_size));
+
+    const std::size_t BUFFER_RECORDS = 1024;
+    unsigned char buf[BUFFER_RECORDS * record_size];
+    while (count > 0) {
+      const std::size_t m = count < BUFFER_RECORDS ? count : BUFFER_RECORDS;
+      for (std::size_t i = 0; i < m; i++) {
+        unsigned char* p = buf + i * record_size;
+        detail::store_le32(p, word(params[i].mat1));
+        detail::store_le32(p + 4, word(params[i].mat2));
+        detail::store_le32(p + 8, word(params[i].tmat));
+      }
+      os.write(reinterpret_cast<const char*>(buf),
+               static_cast<std::streamsize>(m * record_size));
+      params += m;
+      count -= m;
+    }
+  }
+
+  /**
+   * Converts the TinyMTDC output for TinyMT32 into a database. The IDs in the
+   * input must be distinct and consecutive, but may be in any order.
+   *
+   * @param text   input stream of the TinyMTDC output
+   * @param binary output stream, which should be opened in binary mode
+   * @throw std::runtime_error if the input is malformed or the IDs are not
+   * consecutive
+   */
+  static void convert(std::istream& text, std::ostream& binary) {
+    std::vector<std::pair<std::uint_least32_t, param_type>> entries;
+    std::string line;
+    std::uint_least32_t id;
+    param_type param;
+    while (std::getline(text, line)) {
+      if (detail::parse_tinymt32dc_line(line, id, param)) {
+        entries.emplace_back(id, param);
+      }
+    }
+    std::sort(entries.begin(), entries.end(),
+              [](const std::pair<std::uint_least32_t, param_type>& a,
+                 const std::pair<std::uint_least32_t, param_type>& b) {
+                return a.first < b.first;
+              });
+    std::vector<param_type> params;
+    params.reserve(entries.size());
+    for (std::size_t i = 0; i < entries.size(); i++) {
+      if (entries[i].first - entries[0].first != i) {
+        throw std::runtime_error("tinymt: IDs are not consecutive");
+      }
+      params.push_back(entries[i].second);
+    }
+    write(binary, entries.empty() ? 0 : entries[0].first, params.data(),
+          params.size());
+  }
+
+  /**
+   * Converts the TinyMTDC output for TinyMT32 into a database, numbering the
+   * parameter sets from `first_id` in the input order and ignoring the IDs in
+   * the input. This is for files that TinyMTDC generated for a single ID.
+   *
+   * @param text     input stream of the TinyMTDC output
+   * @param binary   output stream, which should be opened in binary mode
+   * @param first_id ID of the first parameter set
+   * @throw std::runtime_error if the input is malformed
+   */
+  static void convert(std::istream& text, std::ostream& binary,
+                      std::uint_least32_t first_id) {
+    std::vector<param_type> params;
+    std::string line;
+    std::uint_least32_t id;
+    param_type param;
+    while (std::getline(text, line)) {
+      if (detail::parse_tinymt32dc_line(line, id, param)) {
+        params.push_back(param);
+      }
+    }
+    write(binary, first_id, params.data(), params.size());
+  }
+
+ private:
+  detail::mapped_file file_;
+  std::uint_least32_t first_id_;
+  std::size_t size_;
+
+  static const unsigned char* magic() {
+    static const unsigned char m[8] = {'T', 'M', 'T', '3', '2', 'D', 'C', 'P'};
+    return m;
+  }
+
+  static std::uint_least32_t word(std::uint_fast32_t x) {
+    return static_cast<std::uint_least32_t>(x & 0xffffffffU);
+  }
+
+  std::uint_least64_t index(std::uint_least32_t id) const {
+    // Wraps around for id < first_id.
+    return (static_cast<std::uint_least64_t>(id) - first_id_) & 0xffffffffU;
+  }
+};
+
+}  // namespace tinymt
+
+#endif  // TINYMT_PARAM_DB_H
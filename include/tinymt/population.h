@@ -0,0 +1,553 @@
+/*
+ * population.h (0.1.0-dev)
+ *
+ * Snapshots of large populations of TinyMT32 engines, a part of tinymt-cpp.
+ *
+ *   https://github.com/tueda/tinymt-cpp
+ *
+ * See tinymt.h for the copyright notice and the license.
+ */
+
+#ifndef TINYMT_POPULATION_H
+#define TINYMT_POPULATION_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <new>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "mapped_file.h"
+#include "tinymt.h"
+
+namespace tinymt {
+
+namespace detail {
+
+/**
+ * Kind of a TinyMT32 engine in a population snapshot, with its parameter set
+ * in non-DC mode.
+ */
+template <class Engine>
+struct population_engine_kind;
+
+template <class UIntType, UIntType Mat1, UIntType Mat2, UIntType TMat,
+          bool DoPeriodCertification, class Counter>
+struct population_engine_kind<tinymt_engine<UIntType, 32, Mat1, Mat2, TMat,
+                                            DoPeriodCertification, Counter>> {
+  static constexpr bool is_dc = Mat1 == 0 && Mat2 == 0 && TMat == 0;
+  static constexpr std::uint_least32_t kind = is_dc ? 1 : 0;
+  static constexpr std::uint_least32_t mat1 = Mat1;
+  static constexpr std::uint_least32_t mat2 = Mat2;
+  static constexpr std::uint_least32_t tmat = TMat;
+};
+
+/**
+ * Checksum of population snapshots: 64-bit FNV-1a over the little-endian
+ * 64-bit words of the data, the last one padded with zeros. The data can be
+ * given in pieces of any sizes.
+ */
+class population_checksum {
+ public:
+  population_checksum() : h_(0xcbf29ce484222325U), pending_(0) {}
+
+  void update(const unsigned char* p, std::size_t n) {
+    if (pending_ > 0) {
+      const std::size_t m = std::min(n, std::size_t(8) - pending_);
+      std::copy(p, p + m, buf_ + pending_);
+      pending_ += m;
+      p += m;
+      n -= m;
+      if (pending_ < 8) {
+        return;
+      }
+      mix(buf_);
+    }
+    for (; n >= 8; p += 8, n -= 8) {
+      mix(p);
+    }
+    std::copy(p, p + n, buf_);
+    pending_ = n;
+  }
+
+  std::uint_least64_t finish() {
+    if (pending_ > 0) {
+      std::fill(buf_ + pending_, buf_ + 8, 0);
+      mix(buf_);
+      pending_ = 0;
+    }
+    return h_;
+  }
+
+ private:
+  std::uint_least64_t h_;
+  std::size_t pending_;
+  unsigned char buf_[8];
+
+  void mix(const unsigned char* p) {
+    const std::uint_least64_t w =
+        load_le32(p) |
+        (static_cast<std::uint_least64_t>(load_le32(p + 4)) << 32);
+    h_ = ((h_ ^ w) * 0x100000001b3U) & 0xffffffffffffffffU;
+  }
+};
+
+}  // namespace detail
+
+/**
+ * Read-only snapshot of a population of TinyMT32 engines, e.g., `tinymt32` or
+ * `tinymt32_dc`, stored in a binary file and memory-mapped.
+ *
+ * The file consists of a 64-byte header, the columns and a checksum, all in
+ * little-endian byte order:
+ *
+ *   offset  size  content
+ *        0     8  magic "TMT32POP"
+ *        8     4  format version (1)
+ *       12     4  engine kind (0: fixed parameter set, 1: DC mode)
+ *       16    12  mat1, mat2 and tmat for the kind 0, zero otherwise
+ *       28     4  flags (bit 0: parameter column, bit 1: ID column)
+ *       32     8  number of engines n
+ *       40    24  reserved (0)
+ *       64   16n  state column: status[0], ..., status[3] of each engine
+ *                 parameter column, if any: 12n bytes of (mat1, mat2, tmat)
+ *                 ID column, if any: 4n bytes of parameter-set IDs
+ *   (end - 8)  8  checksum of all the preceding bytes
+ *
+ * The engines in DC mode have either the parameter column or the ID column,
+ * whose IDs refer to parameter sets in an external table, e.g.,
+ * `tinymt32_dc_param_db`.
+ *
+ * Opening a snapshot reads only the header. An engine is made from the mapped
+ * memory when it is requested, so only the pages of the requested engines are
+ * read. `verify()` checks the integrity by the checksum in a single pass.
+ *
+ * @tparam Engine engine type
+ */
+template <class Engine>
+class population_snapshot {
+  using kind_type = detail::population_engine_kind<Engine>;
+
+ public:
+  /**
+   * Type of the engines.
+   */
+  using engine_type = Engine;
+
+  /**
+   * Type of the parameter sets.
+   */
+  using param_type = typename Engine::param_type;
+
+  /**
+   * Size of the header in bytes.
+   */
+  static constexpr std::size_t header_size = 64;
+
+  /**
+   * Format version.
+   */
+  static constexpr std::uint_least32_t version = 1;
+
+  /**
+   * Opens a snapshot file.
+   *
+   * @param path path to the file
+   * @throw std::runtime_error if the file cannot be mapped or is not a valid
+   * snapshot of engines of this type
+   */
+  explicit population_snapshot(const std::string& path)
+      : file_(path),
+        size_(0),
+        params_(nullptr),
+        ids_(nullptr),
+        prototype_(make_prototype()) {
+    const unsigned char* p = file_.data();
+    if (file_.size() < header_size + checksum_size ||
+        !std::equal(p, p + 8, magic()) ||
+        detail::load_le32(p + 8) != version ||
+        detail::load_le32(p + 12) != kind_type::kind ||
+        detail::load_le32(p + 16) != kind_type::mat1 ||
+        detail::load_le32(p + 20) != kind_type::mat2 ||
+        detail::load_le32(p + 24) != kind_type::tmat) {
+      throw std::runtime_error("tinymt: not a snapshot of the engines: " +
+                               path);
+    }
+    const std::uint_least32_t flags = detail::load_le32(p + 28);
+    const std::uint_least64_t count = load_le64(p + 32);
+    const bool has_params = (flags & params_flag) != 0;
+    const bool has_ids = (flags & ids_flag) != 0;
+    const std::uint_least64_t record = state_size +
+                                       (has_params ? param_size : 0) +
+                                       (has_ids ? id_size : 0);
+    const std::uint_least64_t data = file_.size() - header_size - checksum_size;
+    if ((flags & ~(params_flag | ids_flag)) != 0 ||
+        (kind_type::is_dc && !has_params && !has_ids) ||
+        (!kind_type::is_dc && has_params) || data % record != 0 ||
+        data / record != count) {
+      throw std::runtime_error("tinymt: broken snapshot: " + path);
+    }
+    size_ = static_cast<std::size_t>(count);
+    const unsigned char* column = p + header_size + size_ * state_size;
+    if (has_params) {
+      params_ = column;
+      column += size_ * param_size;
+    }
+    if (has_ids) {
+      ids_ = column;
+    }
+  }
+
+  /**
+   * Returns the number of engines.
+   *
+   * @return number of engines
+   */
+  std::size_t size() const { return size_; }
+
+  /**
+   * Checks whether the snapshot has the parameter column.
+   *
+   * @return `true` if the parameter sets are stored, `false` otherwise
+   */
+  bool has_params() const { return params_ != nullptr; }
+
+  /**
+   * Checks whether the snapshot has the ID column.
+   *
+   * @return `true` if the parameter-set IDs are stored, `false` otherwise
+   */
+  bool has_ids() const { return ids_ != nullptr; }
+
+  /**
+   * Returns the parameter-set ID of the engine at the given position, which
+   * requires the ID column.
+   *
+   * @param i position, must be less than `size()`
+   * @return ID
+   */
+  std::uint_least32_t id(std::size_t i) const {
+    return detail::load_le32(ids_ + i * id_size);
+  }
+
+  /**
+   * Returns the engine at the given position, which requires the parameter
+   * column in DC mode.
+   *
+   * @param i position, must be less than `size()`
+   * @return engine
+   * @throw std::runtime_error if the parameter set is not stored
+   */
+  Engine operator[](std::size_t i) const {
+    if (kind_type::is_dc && !has_params()) {
+      throw std::runtime_error("tinymt: no parameter column in the snapshot");
+    }
+    return make(i, [this](std::size_t j) {
+      const unsigned char* q = params_ + j * param_size;
+      return param_type{detail::load_le32(q), detail::load_le32(q + 4),
+                        detail::load_le32(q + 8)};
+    });
+  }
+
+  /**
+   * Returns the engine at the given position, taking its parameter set from
+   * the given table by its ID in DC mode without the parameter column.
+   *
+   * @param i      position, must be less than `size()`
+   * @param params table of parameter sets with `params[id]`, e.g.,
+   * `tinymt32_dc_param_db`
+   * @return engine
+   */
+  template <class ParamTable>
+  Engine get(std::size_t i, const ParamTable& params) const {
+    if (has_params() || !kind_type::is_dc) {
+      return (*this)[i];
+    }
+    return make(i, [this, &params](std::size_t j) {
+      return static_cast<param_type>(params[id(j)]);
+    });
+  }
+
+  /**
+   * Verifies the checksum of the whole file.
+   *
+   * @return `true` if the checksum matches, `false` otherwise
+   */
+  bool verify() const {
+    const std::size_t n = file_.size() - checksum_size;
+    detail::population_checksum sum;
+    sum.update(file_.data(), n);
+    return sum.finish() == load_le64(file_.data() + n);
+  }
+
+  /**
+   * Writes a snapshot of the given engines, with the parameter column in DC
+   * mode. The data is written in blocks through a small buffer.
+   *
+   * @param os      output stream, which should be opened in binary mode
+   * @param engines pointer to the engines
+   * @param count   number of engines
+   */
+  static void write(std::ostream& os, const Engine* engines,
+                    std::size_t count) {
+    write(os, engines, nullptr, count);
+  }
+
+  /**
+   * Writes a snapshot of the given engines with their parameter-set IDs. In DC
+   * mode, the IDs replace the parameter column.
+   *
+   * @param os      output stream, which should be opened in binary mode
+   * @param engines pointer to the engines
+   * @param ids     pointer to the IDs of the parameter sets, or `nullptr`
+   * @param count   number of engines
+   */
+  static void write(std::ostream& os, const Engine* engines,
+                    const std::uint_least32_t* ids, std::size_t count) {
+    const bool has_params = kind_type::is_dc && ids == nullptr;
+    detail::population_checksum sum;
+    unsigned char header[header_size] = {};
+    std::copy(magic(), magic() + 8, header);
+    detail::store_le32(header + 8, version);
+    detail::store_le32(header + 12, kind_type::kind);
+    detail::store_le32(header + 16, kind_type::mat1);
+    detail::store_le32(header + 20, kind_type::mat2);
+    detail::store_le32(header + 24, kind_type::tmat);
+    detail::store_le32(header + 28, (has_params ? params_flag : 0) |
+                                        (ids != nullptr ? ids_flag : 0));
+    store_le64(header + 32, count);
+    put(os, sum, header, header_size);
+
+    const std::size_t BUFFER_ENGINES = 1024;
+    unsigned char buf[BUFFER_ENGINES * state_size];
+    unsigned char saved[Engine::serialized_size];
+    for (std::size_t k = 0; k < count; k += BUFFER_ENGINES) {
+      const std::size_t m = std::min(count - k, BUFFER_ENGINES);
+      for (std::size_t i = 0; i < m; i++) {
+        engines[k + i].save(saved);
+        std::copy(saved, saved + state_size, buf + i * state_size);
+      }
+      put(os, sum, buf, m * state_size);
+    }
+    if (has_params) {
+      for (std::size_t k = 0; k < count; k += BUFFER_ENGINES) {
+        const std::size_t m = std::min(count - k, BUFFER_ENGINES);
+        for (std::size_t i = 0; i < m; i++) {
+          engines[k + i].save(saved);
+          std::copy(saved + state_size, saved + state_size + param_size,
+                    buf + i * param_size);
+        }
+        put(os, sum, buf, m * param_size);
+      }
+    }
+    if (ids != nullptr) {
+      for (std::size_t k = 0; k < count; k += BUFFER_ENGINES) {
+        const std::size_t m = std::min(count - k, BUFFER_ENGINES);
+        for (std::size_t i = 0; i < m; i++) {
+          detail::store_le32(buf + i * id_size, ids[k + i]);
+        }
+        put(os, sum, buf, m * id_size);
+      }
+    }
+
+    unsigned char trailer[checksum_size];
+    store_le64(trailer, sum.finish());
+    os.write(reinterpret_cast<const char*>(trailer),
+             static_cast<std::streamsize>(checksum_size));
+  }
+
+ private:
+  static constexpr std::size_t state_size = 16;
+  static constexpr std::size_t param_size = 12;
+  static constexpr std::size_t id_size = 4;
+  static constexpr std::size_t checksum_size = 8;
+  static constexpr std::uint_least32_t params_flag = 1;
+  static constexpr std::uint_least32_t ids_flag = 2;
+
+  detail::mapped_file file_;
+  std::size_t size_;
+  const unsigned char* params_;
+  const unsigned char* ids_;
+  // Copied and overwritten by load(), which is cheaper than seeding.
+  Engine prototype_;
+
+  static const unsigned char* magic() {
+    static const unsigned char m[8] = {'T', 'M', 'T', '3', '2', 'P', 'O', 'P'};
+    return m;
+  }
+
+  static std::uint_least64_t load_le64(const unsigned char* p) {
+    return detail::load_le32(p) |
+           (static_cast<std::uint_least64_t>(detail::load_le32(p + 4)) << 32);
+  }
+
+  static void store_le64(unsigned char* p, std::uint_least64_t x) {
+    detail::store_le32(p, static_cast<std::uint_least32_t>(x & 0xffffffffU));
+    detail::store_le32(p + 4, static_cast<std::uint_least32_t>(x >> 32));
+  }
+
+  static void put(std::ostream& os, detail::population_checksum& sum,
+                  const unsigned char* p, std::size_t n) {
+    sum.update(p, n);
+    os.write(reinterpret_cast<const char*>(p),
+             static_cast<std::streamsize>(n));
+  }
+
+  template <bool IsDC = kind_type::is_dc, TINYMT_CPP_ENABLE_WHEN(!IsDC)>
+  static Engine make_prototype() {
+    return Engine();
+  }
+
+  template <bool IsDC = kind_type::is_dc, TINYMT_CPP_ENABLE_WHEN(IsDC)>
+  static Engine make_prototype() {
+    return Engine(param_type{detail::tinymt32_default_param_mat1,
+                             detail::tinymt32_default_param_mat2,
+                             detail::tinymt32_default_param_tmat});
+  }
+
+  template <class ParamAt, bool IsDC = kind_type::is_dc,
+            TINYMT_CPP_ENABLE_WHEN(!IsDC)>
+  Engine make(std::size_t i, ParamAt) const {
+    Engine e = prototype_;
+    e.load(file_.data() + header_size + i * state_size);
+    return e;
+  }
+
+  template <class ParamAt, bool IsDC = kind_type::is_dc,
+            TINYMT_CPP_ENABLE_WHEN(IsDC)>
+  Engine make(std::size_t i, ParamAt param_at) const {
+    const param_type param = param_at(i);
+    // The binary form of the engine: the state followed by the parameter set.
+    unsigned char buf[Engine::serialized_size];
+    const unsigned char* state = file_.data() + header_size + i * state_size;
+    std::copy(state, state + state_size, buf);
+    detail::store_le32(buf + 16, static_cast<std::uint_least32_t>(param.mat1));
+    detail::store_le32(buf + 20, static_cast<std::uint_least32_t>(param.mat2));
+    detail::store_le32(buf + 24, static_cast<std::uint_least32_t>(param.tmat));
+    Engine e = prototype_;
+    e.load(buf);
+    return e;
+  }
+};
+
+/**
+ * Population of TinyMT32 engines restored lazily from a snapshot: an engine
+ * is made from the mapped file at the first access and stays in memory,
+ * where it can be used and modified. The storage for the engines is
+ * allocated at once but the memory is committed by the operating system only
+ * when it is touched, so that restoring a part of a large population takes
+ * memory and time only for that part.
+ *
+ * @note Not thread-safe: the first access to any engine modifies the shared
+ * bookkeeping. Touch the engines from a single thread, or all of them by
+ * `materialize_all()` before sharing the population among threads.
+ *
+ * @tparam Engine engine type
+ */
+template <class Engine>
+class lazy_population {
+  static_assert(std::is_trivially_destructible<Engine>::value,
+                "Engine must be trivially destructible");
+
+ public:
+  /**
+   * Type of the engines.
+   */
+  using engine_type = Engine;
+
+  /**
+   * Type of the parameter sets.
+   */
+  using param_type = typename Engine::param_type;
+
+  /**
+   * Opens a snapshot file with the parameter column or in non-DC mode.
+   *
+   * @param path path to the file
+   * @throw std::runtime_error if the file is not a valid snapshot
+   */
+  explicit lazy_population(const std::string& path)
+      : snapshot_(path),
+        storage_(new unsigned char[snapshot_.size() * sizeof(Engine)]),
+        done_(snapshot_.size()) {}
+
+  /**
+   * Opens a snapshot file, taking the parameter sets by their IDs from the
+   * given table in DC mode without the parameter column.
+   *
+   * @param path   path to the file
+   * @param params function returning the parameter set for an ID
+   * @throw std::runtime_error if the file is not a valid snapshot
+   */
+  lazy_population(const std::string& path,
+                  std::function<param_type(std::uint_least32_t)> params)
+      : snapshot_(path),
+        storage_(new unsigned char[snapshot_.size() * sizeof(Engine)]),
+        done_(snapshot_.size()),
+        params_(std::move(params)) {}
+
+  /**
+   * Returns the number of engines.
+   *
+   * @return number of engines
+   */
+  std::size_t size() const { return snapshot_.size(); }
+
+  /**
+   * Returns the engine at the given position, making it at the first access.
+   *
+   * @param i position, must be less than `size()`
+   * @return engine
+   */
+  Engine& operator[](std::size_t i) {
+    Engine* p = engines() + i;
+    if (!done_[i]) {
+      new (p) Engine(params_ ? snapshot_.get(i, table{&params_})
+                             : snapshot_[i]);
+      done_[i] = true;
+    }
+    return *p;
+  }
+
+  /**
+   * Makes all the engines that have not been accessed yet.
+   */
+  void materialize_all() {
+    for (std::size_t i = 0; i < size(); i++) {
+      (*this)[i];
+    }
+  }
+
+  /**
+   * Returns the underlying snapshot.
+   *
+   * @return snapshot
+   */
+  const population_snapshot<Engine>& snapshot() const { return snapshot_; }
+
+ private:
+  struct table {
+    const std::function<param_type(std::uint_least32_t)>* f;
+
+    param_type operator[](std::uint_least32_t id) const { return (*f)(id); }
+  };
+
+  population_snapshot<Engine> snapshot_;
+  // Engines are created by placement new; new[] of unsigned char does not
+  // touch the memory.
+  std::unique_ptr<unsigned char[]> storage_;
+  std::vector<bool> done_;
+  std::function<param_type(std::uint_least32_t)> params_;
+
+  Engine* engines() { return reinterpret_cast<Engine*>(storage_.get()); }
+};
+
+}  // namespace tinymt
+
+#endif  // TINYMT_POPULATION_H
@@ -0,0 +1,324 @@
+/*
+ * thread_engine_pool.h (0.1.0-dev)
+ *
+ * Per-thread engines with cache-line-padded storage, a part of tinymt-cpp.
+ *
+ *   https://github.com/tueda/tinymt-cpp
+ *
+ * See tinymt.h for the copyright notice and the license.
+ */
+
+#ifndef TINYMT_THREAD_ENGINE_POOL_H
+#define TINYMT_THREAD_ENGINE_POOL_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <stdexcept>
+#include <vector>
+
+#include "tinymt.h"
+
+namespace tinymt {
+
+namespace detail {
+
+/**
+ * Size of a cache line, assumed to be 64 bytes.
+ */
+constexpr std::size_t cache_line_size = 64;
+
+/**
+ * Registry of the IDs of the existing pools.
+ */
+class thread_engine_pool_ids {
+ public:
+  /**
+   * Returns the registry for the whole process.
+   *
+   * @return registry
+   */
+  static thread_engine_pool_ids& global() {
+    static thread_engine_pool_ids ids;
+    return ids;
+  }
+
+  thread_engine_pool_ids(const thread_engine_pool_ids&) = delete;
+  thread_engine_pool_ids& operator=(const thread_engine_pool_ids&) = delete;
+
+  /**
+   * Returns a new ID, never reused within the process, and registers it.
+   *
+   * @return ID
+   */
+  std::uint_least64_t acquire() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    // Kept sorted because the IDs are increasing.
+    live_.push_back(next_);
+    return next_++;
+  }
+
+  /**
+   * Unregisters the given ID.
+   *
+   * @param id ID
+   */
+  void release(std::uint_least64_t id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    live_.erase(std::lower_bound(live_.begin(), live_.end(), id));
+  }
+
+  /**
+   * Removes the entries whose `pool_id` is not registered.
+   *
+   * @param entries entries
+   */
+  template <class Entries>
+  void remove_released(Entries& entries) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    entries.erase(
+        std::remove_if(entries.begin(), entries.end(),
+                       [this](const typename Entries::value_type& e) {
+                         return !std::binary_search(live_.begin(), live_.end(),
+                                                    e.pool_id);
+                       }),
+        entries.end());
+  }
+
+ private:
+  thread_engine_pool_ids() = default;
+
+  mutable std::mutex mutex_;
+  std::uint_least64_t next_ = 1;
+  std::vector<std::uint_least64_t> live_;
+};
+
+/**
+ * ID of a pool, registered while the object exists.
+ */
+class thread_engine_pool_id {
+ public:
+  thread_engine_pool_id()
+      : value_(thread_engine_pool_ids::global().acquire()) {}
+
+  ~thread_engine_pool_id() { thread_engine_pool_ids::global().release(value_); }
+
+  thread_engine_pool_id(const thread_engine_pool_id&) = delete;
+  thread_engine_pool_id& operator=(const thread_engine_pool_id&) = delete;
+
+  /**
+   * Returns the ID.
+   *
+   * @return ID
+   */
+  std::uint_least64_t value() const { return value_; }
+
+ private:
+  std::uint_least64_t value_;
+};
+
+}  // namespace detail
+
+/**
+ * Pool of engines, one for each thread, each of which occupies its own cache
+ * lines so that threads never share a cache line through their engines.
+ *
+ * The engines are created up front by the constructor, and the engine of
+ * ordinal `i` is always initialized in the same way, e.g., with the seed
+ * `base_seed + i`. A thread either accesses an engine by an ordinal of its
+ * choice, e.g., the OpenMP thread number, which gives fully reproducible
+ * results, or calls `local()`, which assigns the ordinals to threads in the
+ * order of their first calls.
+ *
+ * `local()` is lock-free: after the first call by a thread, it only compares
+ * a thread-local cache entry. When a thread switches to another pool, it scans
+ * the list of the pools it has used; the entries of destroyed pools are removed
+ * from the list from time to time, so the list stays within about twice the
+ * number of existing pools the thread has used.
+ *
+ * @tparam Engine engine type
+ */
+template <class Engine>
+class thread_engine_pool {
+  struct alignas(detail::cache_line_size) slot {
+    Engine engine;
+
+    explicit slot(const Engine& e) : engine(e) {}
+  };
+
+  struct local_entry {
+    std::uint_least64_t pool_id;
+    std::size_t ordinal;
+  };
+
+ public:
+  /**
+   * Type of the engines.
+   */
+  using engine_type = Engine;
+
+  /**
+   * Integral type generated by the engines.
+   */
+  using result_type = typename Engine::result_type;
+
+  /**
+   * Constructs the pool of engines seeded with `base_seed + i` for the
+   * ordinals `i` = 0, ..., `size` - 1.
+   *
+   * @param size      number of engines
+   * @param base_seed seed of the first engine
+   */
+  explicit thread_engine_pool(std::size_t size, result_type base_seed = 1)
+      : size_(0), next_(0) {
+    allocate(size);
+    for (; size_ < size; size_++) {
+      new (&slots_[size_]) slot(Engine(static_cast<result_type>(
+          base_seed + static_cast<result_type>(size_))));
+    }
+  }
+
+  /**
+   * Constructs the pool of engines in DC mode, with the parameter set
+   * `params[i]` for the ordinal `i`.
+   *
+   * @param params parameter sets, one for each engine
+   * @param seed   seed for all the engines
+   */
+  template <class ParamType>
+  explicit thread_engine_pool(const std::vector<ParamType>& params,
+                              result_type seed = 1)
+      : size_(0), next_(0) {
+    allocate(params.size());
+    for (; size_ < params.size(); size_++) {
+      new (&slots_[size_]) slot(Engine(params[size_], seed));
+    }
+  }
+
+  thread_engine_pool(const thread_engine_pool&) = delete;
+  thread_engine_pool& operator=(const thread_engine_pool&) = delete;
+
+  ~thread_engine_pool() {
+    for (std::size_t i = 0; i < size_; i++) {
+      slots_[i].~slot();
+    }
+  }
+
+  /**
+   * Returns the number of engines.
+   *
+   * @return number of engines
+   */
+  std::size_t size() const { return size_; }
+
+  /**
+   * Returns the engine for the given ordinal.
+   *
+   * @param ordinal ordinal, must be less than `size()`
+   * @return engine
+   */
+  engine_type& operator[](std::size_t ordinal) {
+    return slots_[ordinal].engine;
+  }
+
+  /**
+   * Returns the engine for the given ordinal.
+   *
+   * @param ordinal ordinal, must be less than `size()`
+   * @return engine
+   */
+  const engine_type& operator[](std::size_t ordinal) const {
+    return slots_[ordinal].engine;
+  }
+
+  /**
+   * Returns the engine for the calling thread, assigning the next free
+   * ordinal to the thread at its first call.
+   *
+   * @return engine
+   * @throw std::out_of_range if all the engines have already been assigned to
+   * other threads
+   */
+  engine_type& local() { return slots_[local_ordinal()].engine; }
+
+  /**
+   * Returns the ordinal for the calling thread, assigning the next free one to
+   * the thread at its first call.
+   *
+   * @return ordinal
+   * @throw std::out_of_range if all the engines have already been assigned to
+   * other threads
+   */
+  std::size_t local_ordinal() {
+    local_entry& last = last_entry();
+    if (last.pool_id != id_.value()) {
+      last = find_or_assign();
+    }
+    return last.ordinal;
+  }
+
+ private:
+  std::unique_ptr<unsigned char[]> storage_;
+  slot* slots_;
+  const detail::thread_engine_pool_id id_;
+  std::size_t size_;
+  std::atomic<std::size_t> next_;
+
+  void allocate(std::size_t size) {
+    // new[] of over-aligned types is not guaranteed before C++17.
+    std::size_t space = (size + 1) * sizeof(slot);
+    storage_.reset(new unsigned char[space]);
+    void* p = storage_.get();
+    slots_ = static_cast<slot*>(std::align(alignof(slot), size * sizeof(slot),
+                                           p, space));
+  }
+
+  // Cache of the last pool used by the thread, which makes the hot path a
+  // single comparison.
+  static local_entry& last_entry() {
+    static thread_local local_entry entry = {0, 0};
+    return entry;
+  }
+
+  // All pools used by the thread. Entries of destroyed pools are never
+  // matched again because pool IDs are not reused, and are removed when the
+  // list has doubled since the last removal.
+  struct local_entries {
+    std::vector<local_entry> v;
+    std::size_t prune_at = 16;
+  };
+
+  static local_entries& entries() {
+    static thread_local local_entries list;
+    return list;
+  }
+
+  local_entry find_or_assign() {
+    local_entries& list = entries();
+    std::vector<local_entry>& v = list.v;
+    for (const local_entry& e : v) {
+      if (e.pool_id == id_.value()) {
+        return e;
+      }
+    }
+    const std::size_t ordinal = next_.fetch_add(1);
+    if (ordinal >= size_) {
+      throw std::out_of_range("tinymt: no free engine in the pool");
+    }
+    if (v.size() >= list.prune_at) {
+      detail::thread_engine_pool_ids::global().remove_released(v);
+      list.prune_at = std::max<std::size_t>(16, 2 * v.size());
+    }
+    const local_entry e = {id_.value(), ordinal};
+    v.push_back(e);
+    return e;
+  }
+};
+
+}  // namespace tinymt
+
+#endif  // TINYMT_THREAD_ENGINE_POOL_H
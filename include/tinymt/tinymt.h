@@ -51,13 +51,80 @@
 #ifndef TINYMT_TINYMT_H
 #define TINYMT_TINYMT_H
 
+#include <algorithm>
 #include <array>
+#include <bitset>
+#include <cmath>
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include <istream>
+#include <iterator>
 #include <limits>
+#include <memory>
 #include <ostream>
+#include <stdexcept>
 #include <type_traits>
+#include <unordered_set>
+#include <utility>
+
+/**
+ * Whether to use the carry-less multiplication instruction (PCLMULQDQ) in the
+ * polynomial arithmetic over GF(2), which speeds up `discard()` and the search
+ * of parameter sets.
+ *
+ * @note It is enabled by default when the compiler targets x86-64 with
+ * PCLMULQDQ, e.g., with `-mpclmul` or `-march=native`. Define
+ * `TINYMT_CPP_USE_CLMUL` to 0 or 1 to override the detection.
+ */
+#ifndef TINYMT_CPP_USE_CLMUL
+#if defined(__PCLMUL__) && (defined(__x86_64__) || defined(_M_X64))
+#define TINYMT_CPP_USE_CLMUL 1
+#else
+#define TINYMT_CPP_USE_CLMUL 0
+#endif
+#endif
+
+#if TINYMT_CPP_USE_CLMUL
+#include <wmmintrin.h>
+#endif
+
+/**
+ * Whether to compile the kernels of `tinymt_engine_array` also for AVX2 and
+ * AVX-512, and to choose one of them at run time by the features of the CPU.
+ *
+ * @note It is enabled by default when GCC or Clang targets x86-64. Define
+ * `TINYMT_CPP_USE_TARGET_CLONES` to 0 or 1 to override the detection.
+ */
+#ifndef TINYMT_CPP_USE_TARGET_CLONES
+#if (defined(__GNUC__) || defined(__clang__)) && defined(__x86_64__)
+#define TINYMT_CPP_USE_TARGET_CLONES 1
+#else
+#define TINYMT_CPP_USE_TARGET_CLONES 0
+#endif
+#endif
+
+/**
+ * Whether the engines can be used in constant expressions: seeded, stepped and
+ * called at compile time. This requires the relaxed constexpr of C++14 and the
+ * constexpr `std::array` of C++17.
+ */
+#if defined(__cpp_constexpr) && __cpp_constexpr >= 201304L && \
+    defined(__cpp_lib_array_constexpr) && __cpp_lib_array_constexpr >= 201603L
+#define TINYMT_CPP_HAS_CONSTEXPR_ENGINE 1
+#else
+#define TINYMT_CPP_HAS_CONSTEXPR_ENGINE 0
+#endif
+
+/**
+ * Specifier for functions that are constexpr when
+ * `TINYMT_CPP_HAS_CONSTEXPR_ENGINE` is 1.
+ */
+#if TINYMT_CPP_HAS_CONSTEXPR_ENGINE
+#define TINYMT_CPP_CONSTEXPR constexpr
+#else
+#define TINYMT_CPP_CONSTEXPR
+#endif
 
 /**
  * Macro to enable/disable function via SFINAE.
@@ -97,6 +164,21 @@ constexpr uint_least32_t tinymt32_default_param_mat2 = 0xfc78ff1fU;
  */
 constexpr uint_least32_t tinymt32_default_param_tmat = 0x3793fdffU;
 
+/**
+ * Default parameter `mat1` of TinyMT64 in the reference implementation.
+ */
+constexpr uint_least32_t tinymt64_default_param_mat1 = 0xfa051f40U;
+
+/**
+ * Default parameter `mat2` of TinyMT64 in the reference implementation.
+ */
+constexpr uint_least32_t tinymt64_default_param_mat2 = 0xffd0fff4U;
+
+/**
+ * Default parameter `tmat` of TinyMT64 in the reference implementation.
+ */
+constexpr uint_least64_t tinymt64_default_param_tmat = 0x58d02ffeffbfffbcU;
+
 /**
  * Checks whether the given integral type `T` (or its signed type) uses 2's
  * complement for the signed integer representation.
@@ -132,6 +214,564 @@ struct is_twos_complement
   static_assert(std::is_integral<T>::value, "T must be an integral type");
 };
 
+/**
+ * Unsigned integral type with the same size as the floating-point type `T`,
+ * together with the bit pattern of `T(1)` in IEEE 754.
+ */
+template <class T>
+struct float_bits;
+
+template <>
+struct float_bits<float> {
+  using type = std::uint_least32_t;
+  static constexpr type one = 0x3f800000U;
+};
+
+template <>
+struct float_bits<double> {
+  using type = std::uint_least64_t;
+  static constexpr type one = 0x3ff0000000000000U;
+};
+
+/**
+ * Checks whether the bits of IEEE 754 numbers of the floating-point type `T`
+ * can be directly manipulated.
+ */
+template <class T>
+struct has_float_bits
+    : std::integral_constant<
+          bool, std::numeric_limits<T>::is_iec559 &&
+                    sizeof(T) == sizeof(typename float_bits<T>::type)> {};
+
+/**
+ * Returns 1 + `m` * epsilon in the floating-point type `T`, i.e., a number in
+ * [1, 2) whose mantissa is given by `m` < 2^(digits-1).
+ */
+template <class T, TINYMT_CPP_ENABLE_WHEN(has_float_bits<T>::value)>
+inline T make_float12(typename float_bits<T>::type m) {
+  // Construct the number directly from its bit pattern.
+  const typename float_bits<T>::type u = float_bits<T>::one | m;
+  T x;
+  std::memcpy(&x, &u, sizeof(T));
+  return x;
+}
+
+template <class T, TINYMT_CPP_ENABLE_WHEN(!has_float_bits<T>::value)>
+inline T make_float12(typename float_bits<T>::type m) {
+  return 1 + static_cast<T>(m) * std::numeric_limits<T>::epsilon();
+}
+
+/**
+ * Checks whether `T` has a member function `generate(It, It)` for bulk
+ * generation.
+ */
+template <class T, class It>
+struct has_generate {
+  template <class U>
+  static auto test(int)
+      -> decltype(std::declval<U&>().generate(std::declval<It>(),
+                                              std::declval<It>()),
+                  std::true_type());
+
+  template <class U>
+  static std::false_type test(...);
+
+  static constexpr bool value = decltype(test<T>(0))::value;
+};
+
+/**
+ * Checks whether the uniform random bit generator `G` generates full 32-bit or
+ * 64-bit words.
+ */
+template <class G>
+struct is_word_generator
+    : std::integral_constant<bool, G::min() == 0 &&
+                                       (G::max() == 0xffffffffU ||
+                                        G::max() == 0xffffffffffffffffU)> {};
+
+/**
+ * Takes a 32-bit word from an output of the generator `G`: the output itself
+ * for 32-bit generators, or its upper half for 64-bit generators.
+ */
+template <class G, TINYMT_CPP_ENABLE_WHEN(G::max() == 0xffffffffU)>
+inline std::uint_least32_t to_word32(typename G::result_type x) {
+  return static_cast<std::uint_least32_t>(x);
+}
+
+template <class G, TINYMT_CPP_ENABLE_WHEN(G::max() != 0xffffffffU)>
+inline std::uint_least32_t to_word32(typename G::result_type x) {
+  return static_cast<std::uint_least32_t>(x >> 32);
+}
+
+/**
+ * Fills the given range with outputs of the generator, in bulk if possible.
+ */
+template <class G, class It, TINYMT_CPP_ENABLE_WHEN(has_generate<G, It>::value)>
+inline void generate_words(G& g, It first, It last) {
+  g.generate(first, last);
+}
+
+template <class G, class It,
+          TINYMT_CPP_ENABLE_WHEN(!has_generate<G, It>::value)>
+inline void generate_words(G& g, It first, It last) {
+  for (; first != last; ++first) {
+    *first = g();
+  }
+}
+
+/**
+ * Generator adaptor that takes the outputs of `g` in blocks, to produce a known
+ * number of results each of which consumes at least one output. The outputs
+ * are returned in the same order as `g` would return them, and `g` is never
+ * advanced beyond the outputs actually used.
+ */
+template <class G>
+class word_buffer {
+ public:
+  using result_type = typename G::result_type;
+
+  static constexpr result_type min() { return G::min(); }
+
+  static constexpr result_type max() { return G::max(); }
+
+  word_buffer(G& g, std::size_t results)
+      : g_(g), results_(results), pos_(0), size_(0) {}
+
+  result_type operator()() {
+    if (pos_ == size_) {
+      // At least one output is needed for each unfinished result.
+      const std::size_t capacity = BUFFER_SIZE;
+      size_ = results_ < capacity ? results_ : capacity;
+      generate_words(g_, buf_, buf_ + size_);
+      pos_ = 0;
+    }
+    return buf_[pos_++];
+  }
+
+  /**
+   * Notifies that one result has been made.
+   */
+  void finish_one() { results_--; }
+
+ private:
+  static constexpr std::size_t BUFFER_SIZE = 256;
+
+  G& g_;
+  std::size_t results_;
+  std::size_t pos_;
+  std::size_t size_;
+  result_type buf_[BUFFER_SIZE];
+};
+
+/**
+ * Draws a 32-bit word from the generator.
+ */
+template <class G>
+inline std::uint_least32_t draw_word32(G& g) {
+  return to_word32<G>(g());
+}
+
+/**
+ * Draws a 64-bit word from the generator, using two outputs (upper half first)
+ * for 32-bit generators.
+ */
+template <class G>
+inline std::uint_least64_t draw_word64(G& g) {
+  if (G::max() == 0xffffffffU) {
+    const std::uint_least64_t hi = g();
+    return (hi << 32) | static_cast<std::uint_least64_t>(g());
+  }
+  return static_cast<std::uint_least64_t>(g());
+}
+
+/**
+ * Returns a number in [0, 1) made from an output of the generator `G` (32-bit
+ * or 64-bit words): the upper bits of the output, as many as the mantissa has,
+ * are put into the mantissa of a number in [1, 2), from which 1 is subtracted.
+ * A 32-bit output is used entirely for `double`, which gives `x` * 2^-32.
+ */
+template <class RealType, class G>
+inline RealType word_to_real01(typename G::result_type x) {
+  using bits_type = typename float_bits<RealType>::type;
+  const std::size_t word_bits = G::max() == 0xffffffffU ? 32 : 64;
+  const std::size_t mantissa_bits =
+      static_cast<std::size_t>(std::numeric_limits<RealType>::digits - 1);
+  const std::size_t rshift =
+      word_bits > mantissa_bits ? word_bits - mantissa_bits : 0;
+  const std::size_t lshift =
+      mantissa_bits > word_bits ? mantissa_bits - word_bits : 0;
+  return make_float12<RealType>(static_cast<bits_type>(x >> rshift)
+                                << lshift) -
+         1;
+}
+
+/**
+ * Checks whether `G` has a member function
+ * `generate_transform(T*, std::size_t, op)`.
+ */
+template <class G, class T>
+struct has_generate_transform {
+  struct op {
+    T operator()(typename G::result_type) const;
+  };
+
+  template <class U>
+  static auto test(int)
+      -> decltype(std::declval<U&>().generate_transform(
+                      std::declval<T*>(), std::size_t(), op()),
+                  std::true_type());
+
+  template <class U>
+  static std::false_type test(...);
+
+  static constexpr bool value = decltype(test<G>(0))::value;
+};
+
+/**
+ * Function object for `fill_uniform()`.
+ */
+template <class RealType, class G>
+struct uniform_real_op {
+  RealType a;
+  RealType d;
+
+  RealType operator()(typename G::result_type x) const {
+    return a + d * word_to_real01<RealType, G>(x);
+  }
+};
+
+/**
+ * Implementation of `fill_uniform()` with `d` = `b` - `a`.
+ */
+template <class RealType, class G>
+inline void fill_uniform(RealType* p, std::size_t n, G& g, RealType a,
+                         RealType d, std::true_type /* generate_transform */) {
+  g.generate_transform(p, n, uniform_real_op<RealType, G>{a, d});
+}
+
+template <class RealType, class G>
+inline void fill_uniform(RealType* p, std::size_t n, G& g, RealType a,
+                         RealType d, std::false_type /* generate_transform */) {
+  const uniform_real_op<RealType, G> op = {a, d};
+  const std::size_t BLOCK_SIZE = 256;
+  typename G::result_type buf[BLOCK_SIZE];
+  while (n > 0) {
+    const std::size_t m = n < BLOCK_SIZE ? n : BLOCK_SIZE;
+    generate_words(g, buf, buf + m);
+    for (std::size_t i = 0; i < m; i++) {
+      p[i] = op(buf[i]);
+    }
+    p += m;
+    n -= m;
+  }
+}
+
+/**
+ * Computes the full 128-bit product of two 64-bit words.
+ *
+ * @param a  multiplicand
+ * @param b  multiplier
+ * @param lo lower 64 bits of the product
+ * @return upper 64 bits of the product
+ */
+inline std::uint_least64_t mul64(std::uint_least64_t a, std::uint_least64_t b,
+                                 std::uint_least64_t& lo) {
+  const std::uint_least64_t mask32 = 0xffffffffU;
+  const std::uint_least64_t mask64 = 0xffffffffffffffffU;
+  const std::uint_least64_t a0 = a & mask32;
+  const std::uint_least64_t a1 = a >> 32;
+  const std::uint_least64_t b0 = b & mask32;
+  const std::uint_least64_t b1 = b >> 32;
+  const std::uint_least64_t p00 = a0 * b0;
+  const std::uint_least64_t p01 = a0 * b1;
+  const std::uint_least64_t p10 = a1 * b0;
+  const std::uint_least64_t p11 = a1 * b1;
+  const std::uint_least64_t mid =
+      (p00 >> 32) + (p01 & mask32) + (p10 & mask32);
+  lo = ((mid << 32) | (p00 & mask32)) & mask64;
+  return (p11 + (p01 >> 32) + (p10 >> 32) + (mid >> 32)) & mask64;
+}
+
+/**
+ * Maps a uniform 32-bit word to [0, s) by Lemire's nearly divisionless method,
+ * drawing more words from `g` on rejection.
+ *
+ * @param x first word
+ * @param s size of the range, 0 < s < 2^32
+ * @param g generator
+ * @return the bounded value
+ */
+template <class G>
+inline std::uint_least32_t bounded32(std::uint_least32_t x,
+                                     std::uint_least32_t s, G& g) {
+  std::uint_least64_t m = static_cast<std::uint_least64_t>(x) * s;
+  auto l = static_cast<std::uint_least32_t>(m & 0xffffffffU);
+  if (l < s) {
+    // 2^32 mod s; the division is needed only in this rare case.
+    const std::uint_least32_t t = (0xffffffffU - s + 1) % s;
+    while (l < t) {
+      m = static_cast<std::uint_least64_t>(draw_word32(g)) * s;
+      l = static_cast<std::uint_least32_t>(m & 0xffffffffU);
+    }
+  }
+  return static_cast<std::uint_least32_t>(m >> 32);
+}
+
+/**
+ * Maps a uniform 64-bit word to [0, s) by Lemire's nearly divisionless method,
+ * drawing more words from `g` on rejection.
+ *
+ * @param s size of the range, 0 < s < 2^64
+ * @param g generator
+ * @return the bounded value
+ */
+template <class G>
+inline std::uint_least64_t bounded64(std::uint_least64_t s, G& g) {
+  std::uint_least64_t l;
+  std::uint_least64_t h = mul64(draw_word64(g), s, l);
+  if (l < s) {
+    // 2^64 mod s.
+    const std::uint_least64_t mask64 = 0xffffffffffffffffU;
+    const std::uint_least64_t t = ((mask64 - s + 1) & mask64) % s;
+    while (l < t) {
+      h = mul64(draw_word64(g), s, l);
+    }
+  }
+  return h;
+}
+
+/**
+ * Maps a uniform 32-bit word to a pair of values in [0, s1) x [0, s2) by the
+ * batched version of Lemire's method (Brackett-Rozinsky and Lemire, 2024):
+ * the word is multiplied by `s1` and the lower half of the product by `s2`.
+ * More words are drawn from `g` on rejection.
+ *
+ * @param s1 size of the first range, 0 < s1
+ * @param s2 size of the second range, 0 < s2, `s1 * s2 < 2^32`
+ * @param j1 first value
+ * @param j2 second value
+ * @param g  generator
+ */
+template <class G>
+inline void bounded32_pair(std::uint_least32_t s1, std::uint_least32_t s2,
+                           std::uint_least32_t& j1, std::uint_least32_t& j2,
+                           G& g) {
+  const std::uint_least64_t mask32 = 0xffffffffU;
+  const std::uint_least64_t prod = static_cast<std::uint_least64_t>(s1) * s2;
+  std::uint_least64_t m = static_cast<std::uint_least64_t>(draw_word32(g)) * s1;
+  j1 = static_cast<std::uint_least32_t>(m >> 32);
+  m = (m & mask32) * s2;
+  j2 = static_cast<std::uint_least32_t>(m >> 32);
+  if ((m & mask32) < prod) {
+    // 2^32 mod (s1 * s2).
+    const std::uint_least64_t t = (mask32 + 1 - prod) % prod;
+    while ((m & mask32) < t) {
+      m = static_cast<std::uint_least64_t>(draw_word32(g)) * s1;
+      j1 = static_cast<std::uint_least32_t>(m >> 32);
+      m = (m & mask32) * s2;
+      j2 = static_cast<std::uint_least32_t>(m >> 32);
+    }
+  }
+}
+
+/**
+ * Returns a uniform random value in [0, s), using a single 32-bit word when
+ * `s <= 2^32`.
+ *
+ * @param s size of the range, 0 < s
+ * @param g generator
+ * @return the bounded value
+ */
+template <class G>
+inline std::uint_least64_t bounded_index(std::uint_least64_t s, G& g) {
+  if (s < 0x100000000U) {
+    return bounded32(draw_word32(g), static_cast<std::uint_least32_t>(s), g);
+  }
+  if (s == 0x100000000U) {
+    return draw_word32(g);
+  }
+  return bounded64(s, g);
+}
+
+/**
+ * Returns the position of the most significant set bit of a nonzero 64-bit
+ * word.
+ */
+inline std::size_t highest_bit(std::uint_least64_t x) {
+#if defined(__GNUC__) || defined(__clang__)
+  return static_cast<std::size_t>(63 ^ __builtin_clzll(x));
+#else
+  std::size_t n = 0;
+  for (std::size_t k = 32; k > 0; k /= 2) {
+    if ((x >> k) != 0) {
+      x >>= k;
+      n += k;
+    }
+  }
+  return n;
+#endif
+}
+
+/**
+ * Returns the binary expansion of a probability `p` in (0, 1) to 64 bits, as
+ * a 64-bit fixed-point number, or 0 for `p` <= 0 or `p` >= 1.
+ */
+inline std::uint_least64_t probability_bits(double p) {
+  if (!(p > 0) || !(p < 1)) {
+    return 0;
+  }
+  return static_cast<std::uint_least64_t>(std::ldexp(p, 64));
+}
+
+/**
+ * Hints that the element pointed to by `it` will be written soon. Does
+ * nothing for iterators that do not refer to objects in memory.
+ */
+template <class It,
+          TINYMT_CPP_ENABLE_WHEN(std::is_lvalue_reference<
+                                 typename std::iterator_traits<It>::reference>::
+                                     value)>
+inline void prefetch(It it) {
+#if defined(__GNUC__)
+  __builtin_prefetch(std::addressof(*it), 1);
+#else
+  static_cast<void>(it);
+#endif
+}
+
+template <class It,
+          TINYMT_CPP_ENABLE_WHEN(!std::is_lvalue_reference<
+                                 typename std::iterator_traits<It>::reference>::
+                                     value)>
+inline void prefetch(It) {}
+
+/**
+ * Returns `a + offset` without intermediate overflow, provided that the result
+ * is representable in `IntType`.
+ */
+template <class IntType>
+inline IntType add_offset(
+    IntType a, typename std::make_unsigned<IntType>::type offset) {
+  using unsigned_type = typename std::make_unsigned<IntType>::type;
+  const auto max =
+      static_cast<unsigned_type>(std::numeric_limits<IntType>::max());
+  if (offset > max) {
+    // Only possible when a < 0.
+    a = static_cast<IntType>(a + std::numeric_limits<IntType>::max());
+    offset = static_cast<unsigned_type>(offset - max);
+  }
+  return static_cast<IntType>(a + static_cast<IntType>(offset));
+}
+
+/**
+ * Reads a 32-bit word stored in little-endian byte order.
+ */
+inline std::uint_least32_t load_le32(const unsigned char* p) {
+  return static_cast<std::uint_least32_t>(p[0]) |
+         (static_cast<std::uint_least32_t>(p[1]) << 8) |
+         (static_cast<std::uint_least32_t>(p[2]) << 16) |
+         (static_cast<std::uint_least32_t>(p[3]) << 24);
+}
+
+/**
+ * Writes a 32-bit word in little-endian byte order.
+ */
+inline void store_le32(unsigned char* p, std::uint_least32_t x) {
+  p[0] = static_cast<unsigned char>(x & 0xff);
+  p[1] = static_cast<unsigned char>((x >> 8) & 0xff);
+  p[2] = static_cast<unsigned char>((x >> 16) & 0xff);
+  p[3] = static_cast<unsigned char>((x >> 24) & 0xff);
+}
+
+/**
+ * Returns a uniform random number in (0, 1) made from a 32-bit word.
+ */
+template <class G>
+inline double uniform_open01(G& g) {
+  return (static_cast<double>(draw_word32(g)) + 0.5) * (1.0 / 4294967296.0);
+}
+
+/**
+ * Tables of the 256-layer ziggurat for the standard normal distribution
+ * (Marsaglia and Tsang, J. Stat. Softw. 5 (2000) 8).
+ */
+struct ziggurat_normal_table {
+  static constexpr std::size_t layers = 256;
+
+  // Right edge of the base layer.
+  double r;
+  // x[i]: right edge of the layer i (x[0] is the width of the rectangle with
+  // the same area as the base layer).
+  std::array<double, layers + 1> x;
+  // f[i] = exp(-x[i]^2 / 2).
+  std::array<double, layers + 1> f;
+  // k[i] = x[i+1] / x[i]: the ratio of the fully covered part of the layer i.
+  std::array<double, layers> k;
+
+  ziggurat_normal_table() : r(3.6541528853610088) {
+    // Area of each layer.
+    const double sqrt_half_pi = std::sqrt(std::atan(1.0) * 2);
+    const double v = r * std::exp(-0.5 * r * r) +
+                     sqrt_half_pi * std::erfc(r / std::sqrt(2.0));
+    x[0] = v / std::exp(-0.5 * r * r);
+    x[1] = r;
+    for (std::size_t i = 1; i < layers - 1; i++) {
+      const double y = v / x[i] + std::exp(-0.5 * x[i] * x[i]);
+      x[i + 1] = std::sqrt(-2 * std::log(y));
+    }
+    x[layers] = 0;
+    for (std::size_t i = 0; i <= layers; i++) {
+      f[i] = std::exp(-0.5 * x[i] * x[i]);
+    }
+    for (std::size_t i = 0; i < layers; i++) {
+      k[i] = x[i + 1] / x[i];
+    }
+  }
+
+  static const ziggurat_normal_table& get() {
+    static const ziggurat_normal_table table;
+    return table;
+  }
+};
+
+/**
+ * Generates a standard normal random number by the ziggurat method, starting
+ * from the given output `w` of the generator `g`. The lowest 8 bits of `w`
+ * select the layer and the upper 24 bits (53 bits for 64-bit generators) give
+ * the signed abscissa; more outputs are drawn only on rejection.
+ */
+template <class G>
+inline double ziggurat_normal(typename G::result_type w, G& g) {
+  const ziggurat_normal_table& t = ziggurat_normal_table::get();
+  const bool is32 = G::max() == 0xffffffffU;
+  const unsigned int shift = is32 ? 8 : 11;
+  const double scale = is32 ? 1.0 / 8388608.0 : 1.0 / 4503599627370496.0;
+  for (;;) {
+    const auto i = static_cast<std::size_t>(w & 0xff);
+    // Uniform in [-1, 1).
+    const double u = static_cast<double>(w >> shift) * scale - 1;
+    const double x = u * t.x[i];
+    if (std::fabs(u) < t.k[i]) {
+      return x;
+    }
+    if (i == 0) {
+      // Sample from the tail beyond r.
+      double a;
+      double b;
+      do {
+        a = -std::log(uniform_open01(g)) / t.r;
+        b = -std::log(uniform_open01(g));
+      } while (b + b < a * a);
+      return u < 0 ? -(t.r + a) : t.r + a;
+    }
+    if (t.f[i] + uniform_open01(g) * (t.f[i + 1] - t.f[i]) <
+        std::exp(-0.5 * x * x)) {
+      return x;
+    }
+    w = g();
+  }
+}
+
 /**
  * Generator's parameter set.
  */
@@ -144,6 +784,10 @@ struct tinymt_engine_param {
 
 /**
  * Generator's state and parameter set.
+ *
+ * The state and the parameters are stored in words of the smallest type of
+ * `WordSize` bits, independently of `UIntType`, e.g., `std::uint_fast32_t`,
+ * which is 64 bits wide on some platforms.
  */
 template <class UIntType, std::size_t WordSize, std::uintmax_t Mat1,
           std::uintmax_t Mat2, std::uintmax_t TMat>
@@ -153,7 +797,8 @@ template <class UIntType, std::uintmax_t Mat1, std::uintmax_t Mat2,
           std::uintmax_t TMat>
 struct tinymt_engine_status<UIntType, 32, Mat1, Mat2, TMat> {
   using result_type = UIntType;
-  std::array<result_type, 4> status;
+  using word_type = std::uint_least32_t;
+  std::array<word_type, 4> status;
   static constexpr result_type mat1 = Mat1;
   static constexpr result_type mat2 = Mat2;
   static constexpr result_type tmat = TMat;
@@ -162,9 +807,31 @@ struct tinymt_engine_status<UIntType, 32, Mat1, Mat2, TMat> {
 
 template <class UIntType>
 struct tinymt_engine_status<UIntType, 32, 0, 0, 0>
-    : tinymt_engine_param<UIntType> {
+    : tinymt_engine_param<std::uint_least32_t> {
+  using result_type = UIntType;
+  using word_type = std::uint_least32_t;
+  std::array<word_type, 4> status;
+  struct is_dynamic : std::true_type {};
+};
+
+template <class UIntType, std::uintmax_t Mat1, std::uintmax_t Mat2,
+          std::uintmax_t TMat>
+struct tinymt_engine_status<UIntType, 64, Mat1, Mat2, TMat> {
+  using result_type = UIntType;
+  using word_type = std::uint_least64_t;
+  std::array<word_type, 2> status;
+  static constexpr result_type mat1 = Mat1;
+  static constexpr result_type mat2 = Mat2;
+  static constexpr result_type tmat = TMat;
+  struct is_dynamic : std::false_type {};
+};
+
+template <class UIntType>
+struct tinymt_engine_status<UIntType, 64, 0, 0, 0>
+    : tinymt_engine_param<std::uint_least64_t> {
   using result_type = UIntType;
-  std::array<result_type, 4> status;
+  using word_type = std::uint_least64_t;
+  std::array<word_type, 2> status;
   struct is_dynamic : std::true_type {};
 };
 
@@ -246,330 +913,3836 @@ inline std::basic_istream<CharT, Traits>& operator>>(
 }
 
 /**
- * Core implementation of the TinyMT algorithms.
+ * Writes the lowest `Bits` bits of a word in little-endian byte order and
+ * returns the end of the written bytes.
  */
-template <class UIntType, std::size_t WordSize, std::uintmax_t Mat1,
-          std::uintmax_t Mat2, std::uintmax_t TMat, bool DoPeriodCertification>
-struct tinymt_engine_impl;
+template <std::size_t Bits, class T>
+inline unsigned char* store_le(unsigned char* p, T x) {
+  for (std::size_t i = 0; i < Bits / 8; i++) {
+    p[i] = static_cast<unsigned char>((x >> (8 * i)) & 0xff);
+  }
+  return p + Bits / 8;
+}
 
-template <class UIntType, std::uintmax_t Mat1, std::uintmax_t Mat2,
-          std::uintmax_t TMat, bool DoPeriodCertification>
-struct tinymt_engine_impl<UIntType, 32, Mat1, Mat2, TMat,
-                          DoPeriodCertification> {
-  using result_type = UIntType;
-  using signed_result_type = typename std::make_signed<result_type>::type;
-  using status_type = tinymt_engine_status<UIntType, 32, Mat1, Mat2, TMat>;
-  using param_type = detail::tinymt_engine_param<UIntType>;
+/**
+ * Reads a `Bits`-bit word in little-endian byte order and returns the end of
+ * the read bytes.
+ */
+template <std::size_t Bits, class T>
+inline const unsigned char* load_le(const unsigned char* p, T& x) {
+  x = 0;
+  for (std::size_t i = 0; i < Bits / 8; i++) {
+    x = static_cast<T>(x | (static_cast<T>(p[i]) << (8 * i)));
+  }
+  return p + Bits / 8;
+}
 
-  static constexpr std::size_t state_size = 4;
-  static constexpr std::uintmax_t max = 0xffffffffU;
+/**
+ * Writes an unsigned integer in decimal without any locale, and returns the end
+ * of the written characters, or `nullptr` if the buffer is too small.
+ */
+template <class T>
+inline char* uint_to_chars(char* first, char* last, T x) {
+  char buf[std::numeric_limits<T>::digits10 + 1];
+  char* p = buf + sizeof(buf);
+  do {
+    *--p = static_cast<char>('0' + static_cast<int>(x % 10));
+    x = static_cast<T>(x / 10);
+  } while (x != 0);
+  const std::size_t n = static_cast<std::size_t>(buf + sizeof(buf) - p);
+  if (static_cast<std::size_t>(last - first) < n) {
+    return nullptr;
+  }
+  return std::copy(p, buf + sizeof(buf), first);
+}
 
-  static constexpr std::size_t sh0 = 1;
+/**
+ * Reads an unsigned integer not greater than `max` in decimal, skipping
+ * leading whitespace as `operator>>` does. Returns the end of the read
+ * characters, or `nullptr` on error.
+ */
+template <class T>
+inline const char* uint_from_chars(const char* first, const char* last, T& x,
+                                   T max) {
+  while (first != last &&
+         (*first == ' ' || (*first >= '\t' && *first <= '\r'))) {
+    ++first;
+  }
+  if (first == last || *first < '0' || *first > '9') {
+    return nullptr;
+  }
+  T y = 0;
+  for (; first != last && *first >= '0' && *first <= '9'; ++first) {
+    const T d = static_cast<T>(*first - '0');
+    if (y > (max - d) / 10) {
+      return nullptr;
+    }
+    y = static_cast<T>(y * 10 + d);
+  }
+  x = y;
+  return first;
+}
+
+/**
+ * Sets the parameter set of a status in DC mode; does nothing otherwise.
+ */
+template <class Status, TINYMT_CPP_ENABLE_WHEN(!Status::is_dynamic::value)>
+inline void set_status_param(Status&, typename Status::word_type,
+                             typename Status::word_type,
+                             typename Status::word_type) {}
+
+template <class Status, TINYMT_CPP_ENABLE_WHEN(Status::is_dynamic::value)>
+inline void set_status_param(Status& s, typename Status::word_type mat1,
+                             typename Status::word_type mat2,
+                             typename Status::word_type tmat) {
+  s.mat1 = mat1;
+  s.mat2 = mat2;
+  s.tmat = tmat;
+}
+
+/**
+ * Binary and text serialization of a status, as the words of the state
+ * followed by mat1, mat2 and tmat in DC mode. In the binary form, mat1 and
+ * mat2 take 32 bits and the others `WordSize` bits, in little-endian byte
+ * order. The text form is the same as that of `operator<<`.
+ */
+template <class Status, std::size_t WordSize>
+struct status_serializer {
+  using word_type = typename Status::word_type;
+
+  static constexpr bool is_dynamic = Status::is_dynamic::value;
+
+  static constexpr std::size_t words =
+      std::tuple_size<decltype(Status::status)>::value;
+
+  static constexpr word_type word_max = static_cast<word_type>(
+      ~static_cast<std::uint_least64_t>(0) >> (64 - WordSize));
+
+  static constexpr std::size_t bytes =
+      words * WordSize / 8 + (is_dynamic ? 8 + WordSize / 8 : 0);
+
+  static constexpr std::size_t max_chars =
+      (words + (is_dynamic ? 3 : 0)) * (WordSize == 32 ? 11 : 21) - 1;
+
+  static void save(const Status& s, unsigned char* p) {
+    for (const auto& x : s.status) {
+      p = store_le<WordSize>(p, x);
+    }
+    if (is_dynamic) {
+      p = store_le<32>(p, s.mat1);
+      p = store_le<32>(p, s.mat2);
+      store_le<WordSize>(p, s.tmat);
+    }
+  }
+
+  static void load(Status& s, const unsigned char* p) {
+    for (auto& x : s.status) {
+      p = load_le<WordSize>(p, x);
+    }
+    if (is_dynamic) {
+      word_type mat1;
+      word_type mat2;
+      word_type tmat;
+      p = load_le<32>(p, mat1);
+      p = load_le<32>(p, mat2);
+      load_le<WordSize>(p, tmat);
+      set_status_param(s, mat1, mat2, tmat);
+    }
+  }
+
+  static char* to_chars(const Status& s, char* first, char* last) {
+    bool sep = false;
+    for (const auto& x : s.status) {
+      first = put(first, last, x, sep);
+    }
+    if (is_dynamic) {
+      first = put(first, last, s.mat1, sep);
+      first = put(first, last, s.mat2, sep);
+      first = put(first, last, s.tmat, sep);
+    }
+    return first;
+  }
+
+  static const char* from_chars(Status& s, const char* first,
+                                const char* last) {
+    std::array<word_type, words> status;
+    for (auto& x : status) {
+      first = get(first, last, x, word_max);
+    }
+    if (is_dynamic) {
+      word_type mat1 = 0;
+      word_type mat2 = 0;
+      word_type tmat = 0;
+      first = get(first, last, mat1, 0xffffffffU);
+      first = get(first, last, mat2, 0xffffffffU);
+      first = get(first, last, tmat, word_max);
+      if (first != nullptr) {
+        set_status_param(s, mat1, mat2, tmat);
+      }
+    }
+    if (first != nullptr) {
+      s.status = status;
+    }
+    return first;
+  }
+
+ private:
+  static char* put(char* first, char* last, word_type x, bool& sep) {
+    if (first == nullptr) {
+      return nullptr;
+    }
+    if (sep) {
+      if (first == last) {
+        return nullptr;
+      }
+      *first++ = ' ';
+    }
+    sep = true;
+    return uint_to_chars(first, last, x);
+  }
+
+  static const char* get(const char* first, const char* last, word_type& x,
+                         word_type max) {
+    return first == nullptr ? nullptr : uint_from_chars(first, last, x, max);
+  }
+};
+
+/**
+ * Degree of the characteristic polynomial of the TinyMT state transition,
+ * i.e., the Mersenne exponent of the period 2^127-1.
+ */
+constexpr std::size_t tinymt_mexp = 127;
+
+/**
+ * Polynomial over GF(2) with degree less than 128. Bit `i % 64` of
+ * `coef[i / 64]` holds the coefficient of x^i.
+ */
+struct f2_polynomial {
+  std::array<std::uint_least64_t, 2> coef;
+};
+
+/**
+ * Mask for the lowest 64 bits of `std::uint_least64_t`.
+ */
+constexpr std::uint_least64_t f2_word_mask = 0xffffffffffffffffU;
+
+/**
+ * Returns the coefficient of x^i in the given polynomial.
+ */
+inline bool f2_coefficient(const f2_polynomial& p, std::size_t i) {
+  return ((p.coef[i / 64] >> (i % 64)) & 1) != 0;
+}
+
+/**
+ * Returns whether the given polynomial is zero.
+ */
+inline bool f2_is_zero(const f2_polynomial& p) {
+  return p.coef[0] == 0 && p.coef[1] == 0;
+}
+
+/**
+ * Multiplies `p` by x modulo `m`, where `m` must have degree `tinymt_mexp` and
+ * `p` must have degree less than that.
+ */
+inline void f2_mulx_mod(f2_polynomial& p, const f2_polynomial& m) {
+  p.coef[1] = ((p.coef[1] << 1) | (p.coef[0] >> 63)) & f2_word_mask;
+  p.coef[0] = (p.coef[0] << 1) & f2_word_mask;
+  if (f2_coefficient(p, tinymt_mexp)) {
+    p.coef[0] ^= m.coef[0];
+    p.coef[1] ^= m.coef[1];
+  }
+}
+
+/**
+ * Polynomial over GF(2) of degree `tinymt_mexp` together with tables for
+ * reduction modulo it.
+ */
+struct f2_modulus {
+  f2_polynomial poly;
+  // x^(tinymt_mexp + k) mod poly for k = 0, ..., tinymt_mexp - 2.
+  std::array<f2_polynomial, tinymt_mexp - 1> reduction_table;
+  // floor(x^(2 * tinymt_mexp) / poly) for Barrett reduction.
+  f2_polynomial barrett;
+};
+
+/**
+ * Prepares the reduction tables for the given polynomial, which must have
+ * degree `tinymt_mexp`.
+ */
+inline f2_modulus f2_make_modulus(const f2_polynomial& m) {
+  f2_modulus mod;
+  mod.poly = m;
+  // x^tinymt_mexp mod m = m - x^tinymt_mexp.
+  f2_polynomial p = m;
+  p.coef[tinymt_mexp / 64] ^= std::uint_least64_t(1) << (tinymt_mexp % 64);
+  for (auto& x : mod.reduction_table) {
+    x = p;
+    f2_mulx_mod(p, m);
+  }
+  // Long division of x^(2 * tinymt_mexp) by m, with the remainder kept in the
+  // window of tinymt_mexp + 1 coefficients that still matters.
+  f2_polynomial r = {{{0, std::uint_least64_t(1) << (tinymt_mexp % 64)}}};
+  mod.barrett = f2_polynomial{{{0, 0}}};
+  for (std::size_t i = tinymt_mexp + 1; i-- > 0;) {
+    if (f2_coefficient(r, tinymt_mexp)) {
+      mod.barrett.coef[i / 64] |= std::uint_least64_t(1) << (i % 64);
+      r.coef[0] ^= m.coef[0];
+      r.coef[1] ^= m.coef[1];
+    }
+    r.coef[1] = ((r.coef[1] << 1) | (r.coef[0] >> 63)) & f2_word_mask;
+    r.coef[0] = (r.coef[0] << 1) & f2_word_mask;
+  }
+  return mod;
+}
+
+#if TINYMT_CPP_USE_CLMUL
+
+/**
+ * Computes the carry-less product of two 64-bit words.
+ */
+inline void f2_clmul(std::uint_least64_t a, std::uint_least64_t b,
+                     std::uint_least64_t& lo, std::uint_least64_t& hi) {
+  const __m128i p =
+      _mm_clmulepi64_si128(_mm_cvtsi64_si128(static_cast<long long>(a)),
+                           _mm_cvtsi64_si128(static_cast<long long>(b)), 0);
+  lo = static_cast<std::uint_least64_t>(_mm_cvtsi128_si64(p));
+  hi = static_cast<std::uint_least64_t>(
+      _mm_cvtsi128_si64(_mm_unpackhi_epi64(p, p)));
+}
+
+/**
+ * Computes the full product of two polynomials of degree less than 128 by
+ * PCLMULQDQ.
+ */
+inline std::array<std::uint_least64_t, 4> f2_mul_clmul(
+    const f2_polynomial& a, const f2_polynomial& b) {
+  std::array<std::uint_least64_t, 4> t;
+  std::uint_least64_t lo;
+  std::uint_least64_t hi;
+  f2_clmul(a.coef[0], b.coef[0], t[0], t[1]);
+  f2_clmul(a.coef[1], b.coef[1], t[2], t[3]);
+  f2_clmul(a.coef[0], b.coef[1], lo, hi);
+  t[1] ^= lo;
+  t[2] ^= hi;
+  f2_clmul(a.coef[1], b.coef[0], lo, hi);
+  t[1] ^= lo;
+  t[2] ^= hi;
+  return t;
+}
+
+/**
+ * Reduces the polynomial `t` of degree less than 2 * `tinymt_mexp` - 1, given
+ * as 4 words in little-endian order, modulo `m` by Barrett reduction with
+ * PCLMULQDQ.
+ */
+inline f2_polynomial f2_reduce_clmul(
+    const std::array<std::uint_least64_t, 4>& t, const f2_modulus& m) {
+  // Barrett reduction: the quotient is floor(floor(t / x^n) * barrett / x^n)
+  // with n = tinymt_mexp, which is exact for polynomials.
+  const f2_polynomial high = {{{(t[1] >> 63) | (t[2] << 1),
+                                (t[2] >> 63) | (t[3] << 1)}}};
+  const std::array<std::uint_least64_t, 4> p = f2_mul_clmul(high, m.barrett);
+  const f2_polynomial q = {{{(p[1] >> 63) | (p[2] << 1),
+                             (p[2] >> 63) | (p[3] << 1)}}};
+  const std::array<std::uint_least64_t, 4> qm = f2_mul_clmul(q, m.poly);
+  return f2_polynomial{{{t[0] ^ qm[0], (t[1] ^ qm[1]) & (f2_word_mask >> 1)}}};
+}
+
+/**
+ * Squares `p` modulo `m` by PCLMULQDQ, where `p` must have degree less than
+ * `tinymt_mexp`.
+ */
+inline void f2_sqr_mod_clmul(f2_polynomial& p, const f2_modulus& m) {
+  std::array<std::uint_least64_t, 4> t;
+  f2_clmul(p.coef[0], p.coef[0], t[0], t[1]);
+  f2_clmul(p.coef[1], p.coef[1], t[2], t[3]);
+  p = f2_reduce_clmul(t, m);
+}
+
+#endif
+
+/**
+ * Computes the full product of two polynomials of degree less than 128
+ * without special instructions.
+ */
+inline std::array<std::uint_least64_t, 4> f2_mul_portable(
+    const f2_polynomial& a, const f2_polynomial& b) {
+  std::array<std::uint_least64_t, 4> t = {{0, 0, 0, 0}};
+  for (std::size_t i = 0; i < 64; i++) {
+    // a * x^i in 3 words.
+    const std::uint_least64_t a0 = (a.coef[0] << i) & f2_word_mask;
+    const std::uint_least64_t a1 =
+        ((a.coef[1] << i) | ((a.coef[0] >> 1) >> (63 - i))) & f2_word_mask;
+    const std::uint_least64_t a2 = (a.coef[1] >> 1) >> (63 - i);
+    for (std::size_t j = 0; j < 2; j++) {
+      // Branchless on purpose: the coefficients are random-looking.
+      const std::uint_least64_t mask =
+          (0 - ((b.coef[j] >> i) & 1)) & f2_word_mask;
+      t[j] ^= mask & a0;
+      t[j + 1] ^= mask & a1;
+      t[j + 2] ^= mask & a2;
+    }
+  }
+  return t;
+}
+
+/**
+ * Reduces the polynomial `t` of degree less than 2 * `tinymt_mexp` - 1, given
+ * as 4 words in little-endian order, modulo `m` by the reduction table.
+ */
+inline f2_polynomial f2_reduce_portable(
+    const std::array<std::uint_least64_t, 4>& t, const f2_modulus& m) {
+  const std::uint_least64_t low_mask = f2_word_mask >> 1;
+  f2_polynomial r = {{{t[0], t[1] & low_mask}}};
+  // Coefficients of x^tinymt_mexp and higher.
+  const std::array<std::uint_least64_t, 2> high = {
+      {(t[1] >> 63) | ((t[2] << 1) & f2_word_mask),
+       (t[2] >> 63) | ((t[3] << 1) & f2_word_mask)}};
+  for (std::size_t k = 0; k < m.reduction_table.size(); k++) {
+    // Branchless on purpose: the coefficients are random-looking.
+    const std::uint_least64_t mask =
+        (0 - ((high[k / 64] >> (k % 64)) & 1)) & f2_word_mask;
+    r.coef[0] ^= mask & m.reduction_table[k].coef[0];
+    r.coef[1] ^= mask & m.reduction_table[k].coef[1];
+  }
+  return r;
+}
+
+/**
+ * Spreads the lower 32 bits of `x` to the even bit positions.
+ */
+inline std::uint_least64_t f2_spread_bits(std::uint_least64_t x) {
+  x &= 0xffffffffU;
+  x = (x | (x << 16)) & 0x0000ffff0000ffffU;
+  x = (x | (x << 8)) & 0x00ff00ff00ff00ffU;
+  x = (x | (x << 4)) & 0x0f0f0f0f0f0f0f0fU;
+  x = (x | (x << 2)) & 0x3333333333333333U;
+  x = (x | (x << 1)) & 0x5555555555555555U;
+  return x;
+}
+
+/**
+ * Squares `p` modulo `m` by the reduction table, where `p` must have degree
+ * less than `tinymt_mexp`.
+ */
+inline void f2_sqr_mod_portable(f2_polynomial& p, const f2_modulus& m) {
+  // Squaring over GF(2) just spreads the coefficients: (sum a_i x^i)^2 =
+  // sum a_i x^(2i).
+  p = f2_reduce_portable(
+      {{f2_spread_bits(p.coef[0]), f2_spread_bits(p.coef[0] >> 32),
+        f2_spread_bits(p.coef[1]), f2_spread_bits(p.coef[1] >> 32)}},
+      m);
+}
+
+/**
+ * Computes the full product of two polynomials of degree less than 128.
+ */
+inline std::array<std::uint_least64_t, 4> f2_mul(const f2_polynomial& a,
+                                                 const f2_polynomial& b) {
+#if TINYMT_CPP_USE_CLMUL
+  return f2_mul_clmul(a, b);
+#else
+  return f2_mul_portable(a, b);
+#endif
+}
+
+/**
+ * Reduces the polynomial `t` of degree less than 2 * `tinymt_mexp` - 1, given
+ * as 4 words in little-endian order, modulo `m`.
+ */
+inline f2_polynomial f2_reduce(const std::array<std::uint_least64_t, 4>& t,
+                               const f2_modulus& m) {
+#if TINYMT_CPP_USE_CLMUL
+  return f2_reduce_clmul(t, m);
+#else
+  return f2_reduce_portable(t, m);
+#endif
+}
+
+/**
+ * Squares `p` modulo `m`, where `p` must have degree less than `tinymt_mexp`.
+ */
+inline void f2_sqr_mod(f2_polynomial& p, const f2_modulus& m) {
+#if TINYMT_CPP_USE_CLMUL
+  f2_sqr_mod_clmul(p, m);
+#else
+  f2_sqr_mod_portable(p, m);
+#endif
+}
+
+/**
+ * Multiplies `p` by `q` modulo `m`, where `p` and `q` must have degree less
+ * than `tinymt_mexp`.
+ */
+inline f2_polynomial f2_mul_mod(const f2_polynomial& p, const f2_polynomial& q,
+                                const f2_modulus& m) {
+  return f2_reduce(f2_mul(p, q), m);
+}
+
+/**
+ * Computes x^z modulo `m`.
+ */
+inline f2_polynomial f2_x_pow_mod(unsigned long long z,  // NOLINT
+                                  const f2_modulus& m) {
+  f2_polynomial r = {{{1, 0}}};
+  std::size_t nbits = 0;
+  while (nbits < std::numeric_limits<unsigned long long>::digits &&  // NOLINT
+         (z >> nbits) != 0) {
+    nbits++;
+  }
+  for (std::size_t i = nbits; i-- > 0;) {
+    f2_sqr_mod(r, m);
+    if (((z >> i) & 1) != 0) {
+      f2_mulx_mod(r, m.poly);
+    }
+  }
+  return r;
+}
+
+/**
+ * Computes `p`^z modulo `m`, where `p` must have degree less than
+ * `tinymt_mexp`.
+ */
+inline f2_polynomial f2_pow_mod(const f2_polynomial& p,
+                                unsigned long long z,  // NOLINT
+                                const f2_modulus& m) {
+  f2_polynomial r = {{{1, 0}}};
+  std::size_t nbits = 0;
+  while (nbits < std::numeric_limits<unsigned long long>::digits &&  // NOLINT
+         (z >> nbits) != 0) {
+    nbits++;
+  }
+  for (std::size_t i = nbits; i-- > 0;) {
+    f2_sqr_mod(r, m);
+    if (((z >> i) & 1) != 0) {
+      r = f2_mul_mod(r, p, m);
+    }
+  }
+  return r;
+}
+
+/**
+ * Checks whether the polynomial `m` of degree `tinymt_mexp` or zero is
+ * primitive, given `x_pow` = x^(2^tinymt_mexp) mod m.
+ */
+inline bool f2_is_primitive(const f2_polynomial& m,
+                            const f2_polynomial& x_pow) {
+  // As tinymt_mexp is prime, m is irreducible, and thus primitive, if and only
+  // if x^(2^tinymt_mexp) = x mod m and m(0) = m(1) = 1 (Rabin's test).
+  return !f2_is_zero(m) && (m.coef[0] & 1) != 0 &&
+         std::bitset<64>(m.coef[0] ^ m.coef[1]).count() % 2 == 1 &&
+         x_pow.coef[0] == 2 && x_pow.coef[1] == 0;
+}
+
+/**
+ * Checks whether the polynomial `m` of degree `tinymt_mexp` or zero is
+ * primitive.
+ */
+inline bool f2_is_primitive(const f2_polynomial& m) {
+  const f2_polynomial x = {{{2, 0}}};
+  // The other conditions are cheap and rule out many polynomials.
+  if (!f2_is_primitive(m, x)) {
+    return false;
+  }
+  const f2_modulus mod = f2_make_modulus(m);
+  f2_polynomial p = x;
+  for (std::size_t i = 0; i < tinymt_mexp; i++) {
+    f2_sqr_mod(p, mod);
+  }
+  return f2_is_primitive(m, p);
+}
+
+/**
+ * Table of x^(2^i) modulo a primitive polynomial of degree `tinymt_mexp`, for
+ * jumps by multiples of powers of two with a few multiplications. Since
+ * x^(2^tinymt_mexp) = x, the table covers all the exponents.
+ */
+struct f2_jump_table {
+  f2_modulus mod;
+  // Whether poly is primitive, without which the table is useless.
+  bool primitive;
+  // x^(-1) mod poly.
+  f2_polynomial x_inverse;
+  // x^(2^i) mod poly for i = 0, ..., tinymt_mexp - 1.
+  std::array<f2_polynomial, tinymt_mexp> pow2;
+};
+
+/**
+ * Prepares the jump table for the given polynomial, which must be of degree
+ * `tinymt_mexp` or zero.
+ */
+inline void f2_make_jump_table(const f2_polynomial& m, f2_jump_table& t) {
+  t.mod = f2_make_modulus(m);
+  // x^(-1) = (m - 1) / x mod m because the constant term of m is 1.
+  t.x_inverse.coef[0] = (m.coef[0] >> 1) | ((m.coef[1] << 63) & f2_word_mask);
+  t.x_inverse.coef[1] = m.coef[1] >> 1;
+  f2_polynomial p = {{{2, 0}}};
+  for (auto& x : t.pow2) {
+    x = p;
+    f2_sqr_mod(p, t.mod);
+  }
+  t.primitive = f2_is_primitive(m, p);
+}
+
+/**
+ * Computes x^(k * 2^e - 1) modulo the polynomial of the given jump table, where
+ * `k` must be positive.
+ */
+inline f2_polynomial f2_x_pow2_mod(std::uint_least64_t k, std::size_t e,
+                                   const f2_jump_table& t) {
+  f2_polynomial r = t.x_inverse;
+  e %= tinymt_mexp;
+  for (; k != 0; k >>= 1) {
+    if ((k & 1) != 0) {
+      r = f2_mul_mod(r, t.pow2[e], t.mod);
+    }
+    e = e + 1 < tinymt_mexp ? e + 1 : 0;
+  }
+  return r;
+}
+
+/**
+ * Computes the minimal polynomial of the given linearly recurrent bit sequence
+ * by the Berlekamp-Massey algorithm.
+ *
+ * @param seq bit sequence of length 2 * `tinymt_mexp`
+ * @return the minimal polynomial if its degree is `tinymt_mexp`, otherwise
+ * zero
+ */
+inline f2_polynomial f2_minimal_polynomial(
+    const std::bitset<2 * tinymt_mexp>& seq) {
+  using bits = std::bitset<2 * tinymt_mexp + 1>;
+  bits c;     // connection polynomial
+  bits b;     // connection polynomial before the last length change
+  bits past;  // bit i holds seq[n - i]
+  c[0] = true;
+  b[0] = true;
+  std::size_t l = 0;
+  std::size_t m = 1;
+  for (std::size_t n = 0; n < seq.size(); n++) {
+    past <<= 1;
+    past[0] = seq[n];
+    if ((c & past).count() % 2 == 0) {
+      m++;
+    } else if (2 * l <= n) {
+      bits t = c;
+      c ^= b << m;
+      l = n + 1 - l;
+      b = t;
+      m = 1;
+    } else {
+      c ^= b << m;
+      m++;
+    }
+  }
+  f2_polynomial p = {{{0, 0}}};
+  if (l == tinymt_mexp) {
+    // Reverse the connection polynomial into the characteristic polynomial.
+    for (std::size_t i = 0; i <= l; i++) {
+      if (c[i]) {
+        p.coef[(l - i) / 64] |= std::uint_least64_t(1) << ((l - i) % 64);
+      }
+    }
+  }
+  return p;
+}
+
+/**
+ * Word-size independent part of the implementation of the TinyMT algorithms,
+ * built on `Impl::next_state` and `Impl::temper`.
+ */
+template <class Impl, class StatusType>
+struct tinymt_engine_impl_common {
+  using status_type = StatusType;
+
+  template <class ForwardIt>
+  static TINYMT_CPP_CONSTEXPR void generate(status_type& s, ForwardIt first,
+                                            ForwardIt last) {
+    using value_type = typename std::iterator_traits<ForwardIt>::value_type;
+
+    // Work on a local copy so that the compiler can keep the state in
+    // registers; stores through `first` cannot alias it.
+    status_type t = s;
+    for (; first != last; ++first) {
+      Impl::next_state(t);
+      *first = static_cast<value_type>(Impl::temper(t));
+    }
+    s.status = t.status;
+  }
+
+  template <class T, class UnaryOp>
+  static void generate_transform(status_type& s, T* p, std::size_t n,
+                                 UnaryOp op) {
+    status_type t = s;
+    for (std::size_t i = 0; i < n; i++) {
+      Impl::next_state(t);
+      p[i] = op(Impl::temper(t));
+    }
+    s.status = t.status;
+  }
+
+  static f2_polynomial characteristic_polynomial(const status_type& s) {
+    // Only the parameter set of `s` is used. The first step projects the state
+    // out of the kernel of the transition, whose dimension is 1 because the
+    // most significant bit of status[0] is dropped.
+    status_type t = s;
+    t.status.fill(0);
+    t.status[Impl::state_size - 1] = 1;
+    Impl::next_state(t);
+    std::bitset<2 * tinymt_mexp> seq;
+    for (std::size_t i = 0; i < seq.size(); i++) {
+      Impl::next_state(t);
+      seq[i] = (t.status[Impl::state_size - 1] & 1) != 0;
+    }
+    return f2_minimal_polynomial(seq);
+  }
+
+  static const f2_jump_table& jump_table(const status_type& s,
+                                         std::false_type /* is_dynamic */) {
+    static const std::unique_ptr<f2_jump_table> t = make_jump_table(s);
+    return *t;
+  }
+
+  static const f2_jump_table& jump_table(const status_type& s,
+                                         std::true_type /* is_dynamic */) {
+    // Direct-mapped cache for each thread, keyed by mat1 and mat2, which
+    // determine the characteristic polynomial.
+    struct entry {
+      typename status_type::result_type mat1;
+      typename status_type::result_type mat2;
+      std::unique_ptr<f2_jump_table> table;
+    };
+    const std::size_t CACHE_SIZE = 16;
+    static thread_local std::array<entry, CACHE_SIZE> cache;
+
+    entry& e = cache[static_cast<std::size_t>(
+                         (s.mat1 ^ (s.mat2 * 0x9e3779b9U)) >> 16) %
+                     CACHE_SIZE];
+    if (!e.table || e.mat1 != s.mat1 || e.mat2 != s.mat2) {
+      e.table = make_jump_table(s);
+      e.mat1 = s.mat1;
+      e.mat2 = s.mat2;
+    }
+    return *e.table;
+  }
+
+  static std::unique_ptr<f2_jump_table> make_jump_table(const status_type& s) {
+    std::unique_ptr<f2_jump_table> t(new f2_jump_table);
+    f2_make_jump_table(characteristic_polynomial(s), *t);
+    return t;
+  }
+
+  static const f2_modulus& characteristic_modulus(const status_type& s) {
+    return jump_table(s, typename status_type::is_dynamic()).mod;
+  }
+
+  static void jump(status_type& s, const f2_polynomial& jump_poly) {
+    // Evaluates jump_poly(next_state) s by Horner's method.
+    status_type work = s;
+    work.status.fill(0);
+    for (std::size_t i = tinymt_mexp; i-- > 0;) {
+      Impl::next_state(work);
+      if (f2_coefficient(jump_poly, i)) {
+        for (std::size_t j = 0; j < Impl::state_size; j++) {
+          work.status[j] ^= s.status[j];
+        }
+      }
+    }
+    s.status = work.status;
+  }
+
+  static TINYMT_CPP_CONSTEXPR void discard(status_type& s,
+                                           unsigned long long z) {  // NOLINT
+    // Below this, stepping one by one is cheaper than the polynomial jump.
+    const unsigned long long JUMP_THRESHOLD = 1024;  // NOLINT
+
+    if (z >= JUMP_THRESHOLD) {
+      const f2_modulus& charpoly = characteristic_modulus(s);
+      if (!f2_is_zero(charpoly.poly)) {
+        // The jump is exact only up to the dropped bit in status[0], which the
+        // last ordinary step overwrites.
+        jump(s, f2_x_pow_mod(z - 1, charpoly));
+        Impl::next_state(s);
+        return;
+      }
+    }
+    for (unsigned long long i = 0; i < z; i++) {  // NOLINT
+      Impl::next_state(s);
+    }
+  }
+
+  // Advances by k * 2^e steps.
+  static void discard_pow2(status_type& s, std::uint_least64_t k,
+                           std::size_t e) {
+    if (k == 0) {
+      return;
+    }
+    const f2_jump_table& t =
+        jump_table(s, typename status_type::is_dynamic());
+    if (!t.primitive) {
+      throw std::domain_error(
+          "tinymt: parameter set without the maximal period");
+    }
+    // As in discard().
+    jump(s, f2_x_pow2_mod(k, e, t));
+    Impl::next_state(s);
+  }
+
+  static void rewind(status_type& s, unsigned long long z) {  // NOLINT
+    // As in discard().
+    const unsigned long long JUMP_THRESHOLD = 1024;  // NOLINT
+
+    if (z >= JUMP_THRESHOLD) {
+      const f2_jump_table& t =
+          jump_table(s, typename status_type::is_dynamic());
+      if (!f2_is_zero(t.mod.poly)) {
+        // x^(-z-1) followed by an ordinary step, which restores the dropped
+        // bit as in discard().
+        jump(s, f2_mul_mod(f2_pow_mod(t.x_inverse, z, t.mod), t.x_inverse,
+                           t.mod));
+        Impl::next_state(s);
+        return;
+      }
+    }
+    if (z > 0) {
+      // undo_step() ignores the dropped bit, which is restored at the end.
+      for (unsigned long long i = 0; i < z; i++) {  // NOLINT
+        Impl::undo_step(s);
+      }
+      Impl::restore_dropped_bit(s);
+    }
+  }
+};
+
+/**
+ * Instruction sets for which the kernels of `tinymt32_lanes` are compiled.
+ */
+enum class simd_level { portable, avx2, avx512 };
+
+/**
+ * Returns the best instruction set supported by the CPU, which is always
+ * `simd_level::portable` when `TINYMT_CPP_USE_TARGET_CLONES` is 0.
+ *
+ * @return instruction set
+ */
+inline simd_level detected_simd_level() {
+#if TINYMT_CPP_USE_TARGET_CLONES
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx512f")) {
+    return simd_level::avx512;
+  }
+  if (__builtin_cpu_supports("avx2")) {
+    return simd_level::avx2;
+  }
+#endif
+  return simd_level::portable;
+}
+
+/**
+ * TinyMT32 for many generators in the structure-of-arrays layout: word `j` of
+ * the state of lane `l` is `status[j][l]`. The loops over the lanes have no
+ * branches so that compilers vectorize them.
+ *
+ * @tparam Lanes number of lanes
+ */
+template <std::size_t Lanes>
+struct tinymt32_lanes {
+  // Words are stored in the narrowest type so that as many lanes as possible
+  // fit in a vector register.
+  using word_type = std::uint_least32_t;
+  using lane_words = std::array<word_type, Lanes>;
+  using status_words = std::array<lane_words, 4>;
+
+  static constexpr std::size_t sh0 = 1;
   static constexpr std::size_t sh1 = 10;
   static constexpr std::size_t sh8 = 8;
 
-  static constexpr result_type word_mask = static_cast<result_type>(max);
-  static constexpr result_type mask32 = word_mask;
-  static constexpr result_type mask = 0x7fffffffU;
+  static constexpr word_type mask32 = 0xffffffffU;
+  static constexpr word_type mask = 0x7fffffffU;
+
+  /**
+   * Advances the state of all the lanes by one step.
+   */
+  static void next_state(status_words& st, const lane_words& mat1,
+                         const lane_words& mat2) {
+    for (std::size_t l = 0; l < Lanes; l++) {
+      word_type x = (st[0][l] & mask) ^ st[1][l] ^ st[2][l];
+      word_type y = st[3][l];
+      x ^= (x << sh0) & mask32;
+      y ^= (y >> sh0) ^ x;
+      // Negation of an unsigned integer is well-defined.
+      const word_type ymask = (0U - (y & 1U)) & mask32;
+      st[0][l] = st[1][l];
+      st[1][l] = st[2][l] ^ (ymask & mat1[l]);
+      st[2][l] = ((x ^ (y << sh1)) & mask32) ^ (ymask & mat2[l]);
+      st[3][l] = y;
+    }
+  }
+
+  /**
+   * Writes the output of each lane for the current state to `p[l]`.
+   */
+  template <class T>
+  static void temper(const status_words& st, const lane_words& tmat, T* p) {
+    for (std::size_t l = 0; l < Lanes; l++) {
+      const word_type t1 = (st[0][l] + (st[2][l] >> sh8)) & mask32;
+      const word_type t1mask = (0U - (t1 & 1U)) & mask32;
+      p[l] = static_cast<T>(st[3][l] ^ t1 ^ (t1mask & tmat[l]));
+    }
+  }
+
+  // Body of the kernels, which is inlined into each of them and compiled for
+  // its instruction set.
+  template <class T>
+#if TINYMT_CPP_USE_TARGET_CLONES
+  __attribute__((always_inline))
+#endif
+  static inline void generate_loop(status_words& st, const lane_words& mat1,
+                            const lane_words& mat2, const lane_words& tmat,
+                            T* p, std::size_t steps) {
+    // Local copies, which cannot alias the output, so that the loops over the
+    // lanes are vectorized.
+    status_words s = st;
+    const lane_words m1 = mat1;
+    const lane_words m2 = mat2;
+    const lane_words tm = tmat;
+    for (std::size_t i = 0; i < steps; i++, p += Lanes) {
+      next_state(s, m1, m2);
+      temper(s, tm, p);
+    }
+    st = s;
+  }
+
+  /**
+   * Type of the kernels that advance the state of all the lanes by `steps`
+   * steps and write the outputs of step `i` to `p[i * Lanes]`, ...,
+   * `p[i * Lanes + Lanes - 1]`.
+   */
+  template <class T>
+  using generate_function = void (*)(status_words&, const lane_words&,
+                                     const lane_words&, const lane_words&, T*,
+                                     std::size_t);
+
+  /**
+   * Kernel for any instruction set, vectorized for the target of the
+   * compilation.
+   */
+  template <class T>
+  static void generate_portable(status_words& st, const lane_words& mat1,
+                                const lane_words& mat2, const lane_words& tmat,
+                                T* p, std::size_t steps) {
+    generate_loop(st, mat1, mat2, tmat, p, steps);
+  }
+
+#if TINYMT_CPP_USE_TARGET_CLONES
+  /**
+   * Kernel for AVX2.
+   */
+  template <class T>
+  __attribute__((target("avx2"))) static void generate_avx2(
+      status_words& st, const lane_words& mat1, const lane_words& mat2,
+      const lane_words& tmat, T* p, std::size_t steps) {
+    generate_loop(st, mat1, mat2, tmat, p, steps);
+  }
+
+  /**
+   * Kernel for AVX-512.
+   */
+  template <class T>
+  __attribute__((target("avx512f"))) static void generate_avx512(
+      status_words& st, const lane_words& mat1, const lane_words& mat2,
+      const lane_words& tmat, T* p, std::size_t steps) {
+    generate_loop(st, mat1, mat2, tmat, p, steps);
+  }
+#endif
+
+  /**
+   * Returns the kernel for the given instruction set, or the portable one if
+   * it is not compiled.
+   *
+   * @param level instruction set, which must be supported by the CPU
+   * @return kernel
+   */
+  template <class T>
+  static generate_function<T> select_generate(simd_level level) {
+#if TINYMT_CPP_USE_TARGET_CLONES
+    switch (level) {
+      case simd_level::avx512:
+        return &generate_avx512<T>;
+      case simd_level::avx2:
+        return &generate_avx2<T>;
+      case simd_level::portable:
+        break;
+    }
+#else
+    static_cast<void>(level);
+#endif
+    return &generate_portable<T>;
+  }
+
+  /**
+   * Same as the kernels, by the best one for the CPU, which is chosen at the
+   * first call.
+   */
+  template <class T>
+  static void generate(status_words& st, const lane_words& mat1,
+                       const lane_words& mat2, const lane_words& tmat, T* p,
+                       std::size_t steps) {
+    static const generate_function<T> f =
+        select_generate<T>(detected_simd_level());
+    f(st, mat1, mat2, tmat, p, steps);
+  }
+};
+
+/**
+ * Core implementation of the TinyMT algorithms.
+ */
+template <class UIntType, std::size_t WordSize, std::uintmax_t Mat1,
+          std::uintmax_t Mat2, std::uintmax_t TMat, bool DoPeriodCertification>
+struct tinymt_engine_impl;
+
+template <class UIntType, std::uintmax_t Mat1, std::uintmax_t Mat2,
+          std::uintmax_t TMat, bool DoPeriodCertification>
+struct tinymt_engine_impl<UIntType, 32, Mat1, Mat2, TMat,
+                          DoPeriodCertification>
+    : tinymt_engine_impl_common<
+          tinymt_engine_impl<UIntType, 32, Mat1, Mat2, TMat,
+                             DoPeriodCertification>,
+          tinymt_engine_status<UIntType, 32, Mat1, Mat2, TMat>> {
+  using result_type = UIntType;
+  using signed_result_type = typename std::make_signed<result_type>::type;
+  using status_type = tinymt_engine_status<UIntType, 32, Mat1, Mat2, TMat>;
+  using word_type = typename status_type::word_type;
+  using param_type = detail::tinymt_engine_param<UIntType>;
+
+  static constexpr std::size_t state_size = 4;
+  static constexpr std::uintmax_t max = 0xffffffffU;
+
+  static constexpr std::size_t sh0 = 1;
+  static constexpr std::size_t sh1 = 10;
+  static constexpr std::size_t sh8 = 8;
+
+  static constexpr result_type word_mask = static_cast<result_type>(max);
+  static constexpr result_type mat_mask = 0xffffffffU;
+  static constexpr result_type mask32 = word_mask;
+  static constexpr result_type mask = 0x7fffffffU;
+
+  static TINYMT_CPP_CONSTEXPR void period_certification(status_type& s) {
+    // In theory, this may happen but I don't know any example, so it is too
+    // difficult to cover these lines.
+
+    // LCOV_EXCL_START
+    if ((s.status[0] & mask) == 0 && s.status[1] == 0 && s.status[2] == 0 &&
+        s.status[3] == 0) {
+      s.status[0] = 'T';
+      s.status[1] = 'I';
+      s.status[2] = 'N';
+      s.status[3] = 'Y';
+    }
+    // LCOV_EXCL_STOP
+  }
+
+  static TINYMT_CPP_CONSTEXPR void init(status_type& s, result_type seed) {
+    const unsigned int MIN_LOOP = 8;
+    const unsigned int PRE_LOOP = 8;
+
+    // Assume that mat1, mat2, tmat have been suitably initialized.
+
+    s.status[0] = static_cast<word_type>(seed & mask32);
+    s.status[1] = static_cast<word_type>(s.mat1);
+    s.status[2] = static_cast<word_type>(s.mat2);
+    s.status[3] = static_cast<word_type>(s.tmat);
+
+    // See Knuth TAOCP Vol2. 3rd Ed. p.106 for the multiplier.
+
+    for (unsigned int i = 1; i < MIN_LOOP; i++) {
+      s.status[i & 3] ^= i + 1812433253 * (s.status[(i - 1) & 3] ^
+                                           (s.status[(i - 1) & 3] >> 30));
+      s.status[i & 3] = static_cast<word_type>(s.status[i & 3] & mask32);
+    }
+
+    if (DoPeriodCertification) {
+      period_certification(s);
+    }
+
+    for (unsigned int i = 0; i < PRE_LOOP; i++) {
+      next_state(s);
+    }
+  }
+
+  // Same as init() for the statuses at(0), ..., at(n - 1), in blocks of lanes
+  // in the structure-of-arrays layout so that the loops over the lanes are
+  // vectorized.
+  template <class StatusAt>
+  static void init_many(StatusAt at, const result_type* seeds, std::size_t n) {
+    const std::size_t LANES = 16;
+    using kernel = tinymt32_lanes<LANES>;
+    using word_type = typename kernel::word_type;
+    const unsigned int MIN_LOOP = 8;
+    const unsigned int PRE_LOOP = 8;
+    const word_type lane_mask32 = kernel::mask32;
+    const word_type lane_mask = kernel::mask;
+
+    for (std::size_t k = 0; k < n; k += LANES) {
+      const std::size_t m = n - k < LANES ? n - k : LANES;
+      typename kernel::status_words st = {};
+      typename kernel::lane_words mat1 = {};
+      typename kernel::lane_words mat2 = {};
+
+      for (std::size_t l = 0; l < m; l++) {
+        const status_type& t = at(k + l);
+        mat1[l] = static_cast<word_type>(t.mat1);
+        mat2[l] = static_cast<word_type>(t.mat2);
+        st[0][l] = static_cast<word_type>(seeds[k + l] & mask32);
+        st[1][l] = mat1[l];
+        st[2][l] = mat2[l];
+        st[3][l] = static_cast<word_type>(t.tmat);
+      }
+
+      for (unsigned int i = 1; i < MIN_LOOP; i++) {
+        for (std::size_t l = 0; l < LANES; l++) {
+          const word_type x = st[(i - 1) & 3][l];
+          st[i & 3][l] ^= i + 1812433253U * (x ^ (x >> 30));
+          st[i & 3][l] &= lane_mask32;
+        }
+      }
+
+      if (DoPeriodCertification) {
+        for (std::size_t l = 0; l < m; l++) {
+          // LCOV_EXCL_START
+          if ((st[0][l] & lane_mask) == 0 && st[1][l] == 0 && st[2][l] == 0 &&
+              st[3][l] == 0) {
+            st[0][l] = 'T';
+            st[1][l] = 'I';
+            st[2][l] = 'N';
+            st[3][l] = 'Y';
+          }
+          // LCOV_EXCL_STOP
+        }
+      }
+
+      for (unsigned int i = 0; i < PRE_LOOP; i++) {
+        kernel::next_state(st, mat1, mat2);
+      }
+
+      for (std::size_t l = 0; l < m; l++) {
+        status_type& t = at(k + l);
+        for (std::size_t j = 0; j < 4; j++) {
+          t.status[j] = st[j][l];
+        }
+      }
+    }
+  }
+
+  // Same as generate_transform() of the base, but a large array is divided
+  // into parts, whose starting states are obtained by jumps, and the parts are
+  // generated together in the structure-of-arrays layout so that the loops
+  // over the lanes are vectorized.
+  template <class T, class UnaryOp>
+  static void generate_transform(status_type& s, T* p, std::size_t n,
+                                 UnaryOp op) {
+    using common = tinymt_engine_impl_common<tinymt_engine_impl, status_type>;
+    const std::size_t LANES = 8;
+    using kernel = tinymt32_lanes<LANES>;
+    using word_type = typename kernel::word_type;
+    const std::size_t BLOCK = 32;
+    // Below this, the jumps cost more than they save.
+    const std::size_t MIN_PART = 16384;
+
+    const std::size_t part = n / LANES;
+    if (part < MIN_PART ||
+        f2_is_zero(common::characteristic_modulus(s).poly)) {
+      common::generate_transform(s, p, n, op);
+      return;
+    }
+
+    typename kernel::status_words st;
+    status_type t = s;
+    for (std::size_t l = 0; l < LANES; l++) {
+      if (l > 0) {
+        common::discard(t, part);
+      }
+      for (std::size_t j = 0; j < 4; j++) {
+        st[j][l] = static_cast<word_type>(t.status[j]);
+      }
+    }
+    typename kernel::lane_words mat1;
+    typename kernel::lane_words mat2;
+    typename kernel::lane_words tmat;
+    mat1.fill(static_cast<word_type>(s.mat1));
+    mat2.fill(static_cast<word_type>(s.mat2));
+    tmat.fill(static_cast<word_type>(s.tmat));
+
+    word_type out[BLOCK][LANES];
+    for (std::size_t i = 0; i < part; i += BLOCK) {
+      const std::size_t m = part - i < BLOCK ? part - i : BLOCK;
+      kernel::generate(st, mat1, mat2, tmat, out[0], m);
+      for (std::size_t l = 0; l < LANES; l++) {
+        T* q = p + l * part + i;
+        for (std::size_t b = 0; b < m; b++) {
+          q[b] = op(static_cast<result_type>(out[b][l]));
+        }
+      }
+    }
+
+    // The last part continues to the end.
+    for (std::size_t j = 0; j < 4; j++) {
+      t.status[j] = st[j][LANES - 1];
+    }
+    common::generate_transform(t, p + LANES * part, n - LANES * part, op);
+    s.status = t.status;
+  }
+
+  template <TINYMT_CPP_ENABLE_WHEN(!is_twos_complement<result_type>::value)>
+  static TINYMT_CPP_CONSTEXPR void next_state(status_type& s) {
+    result_type x = (s.status[0] & mask) ^ s.status[1] ^ s.status[2];
+    result_type y = s.status[3];
+    x ^= (x << sh0) & mask32;
+    y ^= (y >> sh0) ^ x;
+    s.status[0] = s.status[1];
+    s.status[1] = s.status[2];
+    s.status[2] = static_cast<word_type>((x ^ (y << sh1)) & mask32);
+    s.status[3] = static_cast<word_type>(y);
+    if (y & 1) {
+      s.status[1] ^= static_cast<word_type>(s.mat1);
+      s.status[2] ^= static_cast<word_type>(s.mat2);
+    }
+  }
+
+  template <TINYMT_CPP_ENABLE_WHEN(is_twos_complement<result_type>::value)>
+  static TINYMT_CPP_CONSTEXPR void next_state(status_type& s) {
+    result_type x = (s.status[0] & mask) ^ s.status[1] ^ s.status[2];
+    result_type y = s.status[3];
+    x ^= (x << sh0) & mask32;
+    y ^= (y >> sh0) ^ x;
+    s.status[0] = s.status[1];
+    s.status[1] = s.status[2];
+    s.status[2] = static_cast<word_type>((x ^ (y << sh1)) & mask32);
+    s.status[3] = static_cast<word_type>(y);
+    // NOTE: the conditional branch in the portable version can be removed in
+    // the following way using negation in two's complement representation.
+    auto ymask =
+        static_cast<result_type>(-static_cast<signed_result_type>(y & 1));
+    s.status[1] ^= static_cast<word_type>(ymask & s.mat1);
+    s.status[2] ^= static_cast<word_type>(ymask & s.mat2);
+  }
+
+  // Inverse of next_state().
+  static TINYMT_CPP_CONSTEXPR void prev_state(status_type& s) {
+    undo_step(s);
+    restore_dropped_bit(s);
+  }
+
+  // Sets the most significant bit of status[0], which next_state() drops,
+  // to the copy of that of status[1] one step before.
+  static TINYMT_CPP_CONSTEXPR void restore_dropped_bit(status_type& s) {
+    status_type t = s;
+    undo_step(t);
+    s.status[0] = static_cast<word_type>((s.status[0] & mask) |
+                                         (t.status[1] & ~mask & mask32));
+  }
+
+  // Inverse of next_state() except the most significant bit of status[0],
+  // which is left zero.
+  static TINYMT_CPP_CONSTEXPR void undo_step(status_type& s) {
+    const result_type y = s.status[3];
+    const result_type ymask = (y & 1) != 0 ? mask32 : 0;
+    const result_type x =
+        (s.status[2] ^ (ymask & s.mat2) ^ (y << sh1)) & mask32;
+    const result_type s1 = s.status[0];
+    const result_type s2 = s.status[1] ^ (ymask & s.mat1);
+    const result_type s3 = unshift_right(y ^ x, sh0);
+    const result_type xp = unshift_left(x, sh0);
+    // Bit 31 of xp is that of s1 ^ s2 because status[0] is masked.
+    s.status[1] = static_cast<word_type>((s1 & mask) | ((xp ^ s2) & ~mask &
+                                                        mask32));
+    s.status[0] = static_cast<word_type>((xp ^ s.status[1] ^ s2) & mask);
+    s.status[2] = static_cast<word_type>(s2);
+    s.status[3] = static_cast<word_type>(s3);
+  }
+
+  // Solves x = v ^ (v << sh) for v.
+  static TINYMT_CPP_CONSTEXPR result_type unshift_left(result_type x,
+                                                       std::size_t sh) {
+    for (std::size_t k = sh; k < 32; k *= 2) {
+      x ^= (x << k) & mask32;
+    }
+    return x;
+  }
+
+  // Solves x = v ^ (v >> sh) for v.
+  static TINYMT_CPP_CONSTEXPR result_type unshift_right(result_type x,
+                                                        std::size_t sh) {
+    for (std::size_t k = sh; k < 32; k *= 2) {
+      x ^= x >> k;
+    }
+    return x;
+  }
+
+  template <TINYMT_CPP_ENABLE_WHEN(!is_twos_complement<result_type>::value)>
+  static TINYMT_CPP_CONSTEXPR result_type temper(const status_type& s) {
+    result_type t0 = s.status[3];
+    result_type t1 = s.status[0] + (s.status[2] >> sh8);
+    t0 ^= t1;
+    if (t1 & 1) {
+      t0 ^= s.tmat;
+    }
+    return t0 & mask32;
+  }
+
+  template <TINYMT_CPP_ENABLE_WHEN(is_twos_complement<result_type>::value)>
+  static TINYMT_CPP_CONSTEXPR result_type temper(const status_type& s) {
+    result_type t0 = s.status[3];
+    result_type t1 = s.status[0] + (s.status[2] >> sh8);
+    t0 ^= t1;
+    // NOTE: the conditional branch in the portable version can be removed in
+    // the following way using negation in two's complement representation.
+    auto t1mask =
+        static_cast<result_type>(-static_cast<signed_result_type>(t1 & 1));
+    t0 ^= t1mask & s.tmat;
+    return t0 & mask32;
+  }
+};
+
+template <class UIntType, std::uintmax_t Mat1, std::uintmax_t Mat2,
+          std::uintmax_t TMat, bool DoPeriodCertification>
+struct tinymt_engine_impl<UIntType, 64, Mat1, Mat2, TMat,
+                          DoPeriodCertification>
+    : tinymt_engine_impl_common<
+          tinymt_engine_impl<UIntType, 64, Mat1, Mat2, TMat,
+                             DoPeriodCertification>,
+          tinymt_engine_status<UIntType, 64, Mat1, Mat2, TMat>> {
+  using result_type = UIntType;
+  using signed_result_type = typename std::make_signed<result_type>::type;
+  using status_type = tinymt_engine_status<UIntType, 64, Mat1, Mat2, TMat>;
+  using word_type = typename status_type::word_type;
+  using param_type = detail::tinymt_engine_param<UIntType>;
+
+  static constexpr std::size_t state_size = 2;
+  static constexpr std::uintmax_t max = 0xffffffffffffffffU;
+
+  static constexpr std::size_t sh0 = 12;
+  static constexpr std::size_t sh1 = 11;
+  static constexpr std::size_t sh8 = 8;
+
+  static constexpr result_type word_mask = static_cast<result_type>(max);
+  static constexpr result_type mat_mask = 0xffffffffU;
+  static constexpr result_type mask64 = word_mask;
+  static constexpr result_type mask = 0x7fffffffffffffffU;
+
+  static TINYMT_CPP_CONSTEXPR void period_certification(status_type& s) {
+    // LCOV_EXCL_START
+    if ((s.status[0] & mask) == 0 && s.status[1] == 0) {
+      s.status[0] = 'T';
+      s.status[1] = 'M';
+    }
+    // LCOV_EXCL_STOP
+  }
+
+  static TINYMT_CPP_CONSTEXPR void init(status_type& s, result_type seed) {
+    const unsigned int MIN_LOOP = 8;
+
+    // Assume that mat1, mat2, tmat have been suitably initialized. Note that
+    // mat1 and mat2 are 32-bit parameters also in TinyMT64.
+
+    s.status[0] = static_cast<word_type>((seed ^ (s.mat1 << 32)) & mask64);
+    s.status[1] = static_cast<word_type>(s.mat2 ^ s.tmat);
+
+    for (unsigned int i = 1; i < MIN_LOOP; i++) {
+      s.status[i & 1] ^= i + 6364136223846793005U *
+                                 (s.status[(i - 1) & 1] ^
+                                  (s.status[(i - 1) & 1] >> 62));
+      s.status[i & 1] = static_cast<word_type>(s.status[i & 1] & mask64);
+    }
+
+    if (DoPeriodCertification) {
+      period_certification(s);
+    }
+  }
+
+  // Same as init() for the statuses at(0), ..., at(n - 1). The 64-bit
+  // multiplications are hardly vectorized, so this is just a loop.
+  template <class StatusAt>
+  static void init_many(StatusAt at, const result_type* seeds, std::size_t n) {
+    for (std::size_t i = 0; i < n; i++) {
+      init(at(i), seeds[i]);
+    }
+  }
+
+  template <TINYMT_CPP_ENABLE_WHEN(!is_twos_complement<result_type>::value)>
+  static TINYMT_CPP_CONSTEXPR void next_state(status_type& s) {
+    result_type x = (s.status[0] & mask) ^ s.status[1];
+    x ^= (x << sh0) & mask64;
+    x ^= x >> 32;
+    x ^= (x << 32) & mask64;
+    x ^= (x << sh1) & mask64;
+    s.status[0] = s.status[1];
+    s.status[1] = static_cast<word_type>(x);
+    if (x & 1) {
+      s.status[0] ^= static_cast<word_type>(s.mat1);
+      s.status[1] ^= static_cast<word_type>((s.mat2 << 32) & mask64);
+    }
+  }
+
+  template <TINYMT_CPP_ENABLE_WHEN(is_twos_complement<result_type>::value)>
+  static TINYMT_CPP_CONSTEXPR void next_state(status_type& s) {
+    result_type x = (s.status[0] & mask) ^ s.status[1];
+    x ^= (x << sh0) & mask64;
+    x ^= x >> 32;
+    x ^= (x << 32) & mask64;
+    x ^= (x << sh1) & mask64;
+    s.status[0] = s.status[1];
+    s.status[1] = static_cast<word_type>(x);
+    // NOTE: the conditional branch in the portable version can be removed in
+    // the following way using negation in two's complement representation.
+    auto xmask =
+        static_cast<result_type>(-static_cast<signed_result_type>(x & 1));
+    s.status[0] ^= static_cast<word_type>(xmask & s.mat1);
+    s.status[1] ^= static_cast<word_type>(xmask & ((s.mat2 << 32) & mask64));
+  }
+
+  // Inverse of next_state().
+  static TINYMT_CPP_CONSTEXPR void prev_state(status_type& s) {
+    undo_step(s);
+    restore_dropped_bit(s);
+  }
+
+  // Sets the most significant bit of status[0], which next_state() drops,
+  // to that of status[1] one step before.
+  static TINYMT_CPP_CONSTEXPR void restore_dropped_bit(status_type& s) {
+    status_type t = s;
+    undo_step(t);
+    s.status[0] = static_cast<word_type>((s.status[0] & mask) |
+                                         (t.status[1] & ~mask & mask64));
+  }
+
+  // Inverse of next_state() except the most significant bit of status[0],
+  // which is left zero.
+  static TINYMT_CPP_CONSTEXPR void undo_step(status_type& s) {
+    const result_type xmask = (s.status[1] & 1) != 0 ? mask64 : 0;
+    result_type x = s.status[1] ^ (xmask & ((s.mat2 << 32) & mask64));
+    x = unshift_left(x, sh1);
+    x ^= (x << 32) & mask64;
+    x ^= x >> 32;
+    x = unshift_left(x, sh0);
+    // The most significant bit of x is that of s1 because status[0] is
+    // masked.
+    const result_type s1 =
+        ((s.status[0] ^ (xmask & s.mat1)) & mask) | (x & ~mask & mask64);
+    s.status[0] = static_cast<word_type>((x ^ s1) & mask);
+    s.status[1] = static_cast<word_type>(s1);
+  }
+
+  // Solves x = v ^ (v << sh) for v.
+  static TINYMT_CPP_CONSTEXPR result_type unshift_left(result_type x,
+                                                       std::size_t sh) {
+    for (std::size_t k = sh; k < 64; k *= 2) {
+      x ^= (x << k) & mask64;
+    }
+    return x;
+  }
+
+  template <TINYMT_CPP_ENABLE_WHEN(!is_twos_complement<result_type>::value)>
+  static TINYMT_CPP_CONSTEXPR result_type temper(const status_type& s) {
+    result_type x = (s.status[0] + s.status[1]) & mask64;
+    x ^= s.status[0] >> sh8;
+    if (x & 1) {
+      x ^= s.tmat;
+    }
+    return x;
+  }
+
+  template <TINYMT_CPP_ENABLE_WHEN(is_twos_complement<result_type>::value)>
+  static TINYMT_CPP_CONSTEXPR result_type temper(const status_type& s) {
+    result_type x = (s.status[0] + s.status[1]) & mask64;
+    x ^= s.status[0] >> sh8;
+    // NOTE: the conditional branch in the portable version can be removed in
+    // the following way using negation in two's complement representation.
+    auto xmask =
+        static_cast<result_type>(-static_cast<signed_result_type>(x & 1));
+    x ^= xmask & s.tmat;
+    return x;
+  }
+};
+
+/**
+ * Returns `a` + `b`, or the maximum value on overflow.
+ */
+constexpr std::uint_least64_t saturating_add(std::uint_least64_t a,
+                                             std::uint_least64_t b) {
+  return b > std::numeric_limits<std::uint_least64_t>::max() - a
+             ? std::numeric_limits<std::uint_least64_t>::max()
+             : a + b;
+}
+
+/**
+ * Returns `k` * 2^`e`, or the maximum value on overflow.
+ */
+inline std::uint_least64_t saturating_mul_pow2(std::uint_least64_t k,
+                                               std::size_t e) {
+  const std::uint_least64_t max =
+      std::numeric_limits<std::uint_least64_t>::max();
+  if (k == 0) {
+    return 0;
+  }
+  if (e >= static_cast<std::size_t>(
+               std::numeric_limits<std::uint_least64_t>::digits) ||
+      k > max >> e) {
+    return max;
+  }
+  return k << e;
+}
+
+}  // namespace detail
+
+/**
+ * Counter policy of `tinymt_engine` that counts nothing, which is the default.
+ * It takes no space in the engine and its calls are optimized away.
+ *
+ * A counter policy provides the following member functions, which the engine
+ * calls:
+ *
+ * - `on_draw(n)`: `n` numbers generated one by one, e.g., by `operator()`,
+ * - `on_discard(n)`: `n` steps skipped by `discard()`, `advance_pow2()` or
+ *   `split()` (for the returned engine), where `n` is saturated at the maximum
+ *   of `std::uint_least64_t`,
+ * - `on_seed()`: the engine initialized by a constructor, `seed()` or
+ *   `seed_many()`,
+ * - `on_fill(n)`: `n` numbers generated in bulk by `generate()`, `fill()` or
+ *   `generate_transform()`.
+ *
+ * Steps back by `step_back()` and `rewind()` are not counted.
+ */
+class no_counter {
+ public:
+  TINYMT_CPP_CONSTEXPR void on_draw(std::uint_least64_t) {}
+  TINYMT_CPP_CONSTEXPR void on_discard(std::uint_least64_t) {}
+  TINYMT_CPP_CONSTEXPR void on_seed() {}
+  TINYMT_CPP_CONSTEXPR void on_fill(std::uint_least64_t) {}
+};
+
+/**
+ * Counts of the use of engines.
+ */
+struct engine_counts {
+  /**
+   * Number of numbers generated one by one, e.g., by `operator()`.
+   */
+  std::uint_least64_t draws;
+
+  /**
+   * Number of steps skipped by `discard()`, `advance_pow2()` and `split()`,
+   * saturated at the maximum value.
+   */
+  std::uint_least64_t discarded;
+
+  /**
+   * Number of initializations.
+   */
+  std::uint_least64_t seeds;
+
+  /**
+   * Number of numbers generated in bulk, e.g., by `generate()`.
+   */
+  std::uint_least64_t filled;
+};
+
+/**
+ * Counter policy of `tinymt_engine` that counts the use of each engine, which
+ * is obtained by `tinymt_engine::counter().counts()`. The counts are copied
+ * with the engine. Steps back by `step_back()` and `rewind()` are not counted,
+ * nor subtracted from the other counts.
+ */
+class engine_counter {
+ public:
+  /**
+   * Returns the counts.
+   *
+   * @return counts
+   */
+  const engine_counts& counts() const { return counts_; }
+
+  /**
+   * Resets the counts to zero.
+   */
+  void reset_counts() { counts_ = engine_counts(); }
+
+  TINYMT_CPP_CONSTEXPR void on_draw(std::uint_least64_t n) {
+    counts_.draws += n;
+  }
+
+  TINYMT_CPP_CONSTEXPR void on_discard(std::uint_least64_t n) {
+    counts_.discarded = detail::saturating_add(counts_.discarded, n);
+  }
+
+  TINYMT_CPP_CONSTEXPR void on_seed() { counts_.seeds++; }
+
+  TINYMT_CPP_CONSTEXPR void on_fill(std::uint_least64_t n) {
+    counts_.filled += n;
+  }
+
+ private:
+  engine_counts counts_ = engine_counts();
+};
+
+/**
+ * Pseudo-random number generator engine based on the TinyMT algorithms.
+ *
+ * @tparam UIntType unsigned integral type generated by the engine
+ * @tparam WordSize word size for the generated numbers
+ * @tparam Mat1     parameter used in the linear state transition function
+ * @tparam Mat2     parameter used in the linear state transition function
+ * @tparam TMat     parameter used in the non-linear output function
+ * @tparam DoPeriodCertification whether or not period certification is
+ * performed in initialization
+ * @tparam Counter  counter policy, e.g., `no_counter` or `engine_counter`
+ *
+ * @note `WordSize` must be `32` (TinyMT32) or `64` (TinyMT64).
+ * @note When `Mat`, `Mat2` and `TMat` are all zero, the generator parameter set
+ * must be provided in initialization ("Dynamic Creation" (DC) mode).
+ */
+template <class UIntType, std::size_t WordSize, UIntType Mat1, UIntType Mat2,
+          UIntType TMat, bool DoPeriodCertification = true,
+          class Counter = no_counter>
+class tinymt_engine : private Counter {
+  static_assert(std::is_integral<UIntType>::value &&
+                    std::is_unsigned<UIntType>::value,
+                "result_type must be an unsigned integral type");
+  static_assert(WordSize == 32 || WordSize == 64, "word_size must be 32 or 64");
+
+  using impl = detail::tinymt_engine_impl<UIntType, WordSize, Mat1, Mat2, TMat,
+                                          DoPeriodCertification>;
+  using status_type =
+      detail::tinymt_engine_status<UIntType, WordSize, Mat1, Mat2, TMat>;
+  using word_type = typename status_type::word_type;
+
+  static_assert(std::numeric_limits<UIntType>::max() >= impl::max,
+                "size of result_type must be lager than word_size");
+  static_assert(Mat1 <= impl::mat_mask, "Mat1 must be < 2^32");
+  static_assert(Mat2 <= impl::mat_mask, "Mat2 must be < 2^32");
+  static_assert(TMat <= impl::max, "TMat must be < 2^word_size");
+
+  using serializer = detail::status_serializer<status_type, WordSize>;
+
+  status_type s_;
+
+ public:
+  /**
+   * Integral type generated by the engine.
+   */
+  using result_type = UIntType;
+
+  /**
+   * Type of the generator parameter set.
+   */
+  using param_type = typename impl::param_type;
+
+  /**
+   * Word size that determines the range of numbers generated by the engine.
+   */
+  static constexpr std::size_t word_size = WordSize;
+
+  /**
+   * Size of the state of the generator in words.
+   */
+  static constexpr std::size_t state_size = impl::state_size;
+
+  /**
+   * Default seed.
+   */
+  static constexpr result_type default_seed = 1;
+
+  /**
+   * Size of the binary form of the engine state in bytes: 16 for TinyMT32 and
+   * TinyMT64, or 28 and 32, respectively, in DC mode.
+   */
+  static constexpr std::size_t serialized_size = serializer::bytes;
+
+  /**
+   * Maximum length of the text form of the engine state in characters.
+   */
+  static constexpr std::size_t max_chars = serializer::max_chars;
+
+  /**
+   * Constructs the engine (non-DC mode).
+   *
+   * @param seed random seed
+   */
+  template <TINYMT_CPP_ENABLE_WHEN(!status_type::is_dynamic::value)>
+  TINYMT_CPP_CONSTEXPR explicit tinymt_engine(result_type seed = default_seed)
+      : s_() {
+    impl::init(s_, seed);
+    this->on_seed();
+  }
+
+  /**
+   * Constructs the engine (DC mode).
+   *
+   * @param param parameter set
+   * @param seed random seed
+   */
+  template <TINYMT_CPP_ENABLE_WHEN(status_type::is_dynamic::value)>
+  TINYMT_CPP_CONSTEXPR explicit tinymt_engine(const param_type& param,
+                                              result_type seed = default_seed)
+      : s_() {
+    s_.mat1 = static_cast<word_type>(param.mat1 & impl::mat_mask);
+    s_.mat2 = static_cast<word_type>(param.mat2 & impl::mat_mask);
+    s_.tmat = static_cast<word_type>(param.tmat & impl::word_mask);
+    impl::init(s_, seed);
+    this->on_seed();
+  }
+
+  /**
+   * Constructs the engine with the state of an engine with another counter
+   * policy. The counts start from zero.
+   *
+   * @param other engine
+   */
+  template <class OtherCounter,
+            TINYMT_CPP_ENABLE_WHEN(!std::is_same<OtherCounter, Counter>::value)>
+  TINYMT_CPP_CONSTEXPR explicit tinymt_engine(
+      const tinymt_engine<UIntType, WordSize, Mat1, Mat2, TMat,
+                          DoPeriodCertification, OtherCounter>& other)
+      : s_(other.s_) {}
+
+  /**
+   * Reinitializes the engine.
+   *
+   * @param value random seed
+   */
+  TINYMT_CPP_CONSTEXPR void seed(result_type value = default_seed) {
+    impl::init(s_, value);
+    this->on_seed();
+  }
+
+  /**
+   * Reinitializes many engines at once (non-DC mode). Equivalent to
+   * `engines[i].seed(seeds[i])` for `i` = 0, ..., `n` - 1, but TinyMT32
+   * engines are initialized together in blocks by SIMD instructions.
+   *
+   * @param engines pointer to the engines
+   * @param seeds   pointer to the random seeds
+   * @param n       number of engines
+   */
+  template <TINYMT_CPP_ENABLE_WHEN(!status_type::is_dynamic::value)>
+  static void seed_many(tinymt_engine* engines, const result_type* seeds,
+                        std::size_t n) {
+    impl::init_many(
+        [engines](std::size_t i) -> status_type& { return engines[i].s_; },
+        seeds, n);
+    for (std::size_t i = 0; i < n; i++) {
+      engines[i].on_seed();
+    }
+  }
+
+  /**
+   * Reinitializes many engines at once (DC mode). Equivalent to
+   * `engines[i] = tinymt_engine(params[i], seeds[i])` for `i` = 0, ...,
+   * `n` - 1, but TinyMT32 engines are initialized together in blocks by SIMD
+   * instructions.
+   *
+   * @param engines pointer to the engines
+   * @param params  pointer to the parameter sets
+   * @param seeds   pointer to the random seeds
+   * @param n       number of engines
+   */
+  template <TINYMT_CPP_ENABLE_WHEN(status_type::is_dynamic::value)>
+  static void seed_many(tinymt_engine* engines, const param_type* params,
+                        const result_type* seeds, std::size_t n) {
+    for (std::size_t i = 0; i < n; i++) {
+      engines[i].s_.mat1 =
+          static_cast<word_type>(params[i].mat1 & impl::mat_mask);
+      engines[i].s_.mat2 =
+          static_cast<word_type>(params[i].mat2 & impl::mat_mask);
+      engines[i].s_.tmat =
+          static_cast<word_type>(params[i].tmat & impl::word_mask);
+      engines[i].on_seed();
+    }
+    impl::init_many(
+        [engines](std::size_t i) -> status_type& { return engines[i].s_; },
+        seeds, n);
+  }
+
+  /**
+   * Advances the state of the engine by the given amount.
+   *
+   * Large advances are performed by polynomial jumping in O(log z) time. In
+   * constant expressions, `z` must be less than 1024.
+   *
+   * @param z number of advances
+   */
+  // Note: the use of `unsigned long long` is intentional, following the
+  // standard library and the Boost library.
+  TINYMT_CPP_CONSTEXPR void discard(unsigned long long z) {  // NOLINT
+    impl::discard(s_, z);
+    this->on_discard(z);
+  }
+
+  /**
+   * Steps the state of the engine back by one, so that the next call of
+   * `operator()` returns the same number as the last call.
+   *
+   * @note The state right after seeding TinyMT64 has a bit that the generator
+   * never uses. Stepping back beyond it and forward again gives the same
+   * numbers, but the engine may not compare equal to the original one.
+   */
+  TINYMT_CPP_CONSTEXPR void step_back() { impl::prev_state(s_); }
+
+  /**
+   * Steps the state of the engine back by the given amount, which undoes
+   * `discard(z)` or `z` calls of `operator()`.
+   *
+   * For large `z`, the state jumps by the inverse of the state transition
+   * raised to the power of `z`, which is x^(-`z`) modulo the characteristic
+   * polynomial. The polynomial is computed at the first use for the parameter
+   * set (non-DC mode) or cached for each thread and parameter set (DC mode).
+   *
+   * @param z number of steps back
+   */
+  void rewind(unsigned long long z) {  // NOLINT
+    impl::rewind(s_, z);
+  }
+
+  /**
+   * Advances the state of the engine by 2^`e` steps.
+   *
+   * The jump uses a table of x^(2^i) modulo the characteristic polynomial,
+   * which is computed at the first use for the parameter set (non-DC mode) or
+   * cached for each thread and parameter set (DC mode).
+   *
+   * @param e exponent of the number of advances, which may exceed 64
+   * @throw std::domain_error if the parameter set does not give the maximal
+   * period 2^127-1
+   */
+  void advance_pow2(std::size_t e) {
+    impl::discard_pow2(s_, 1, e);
+    this->on_discard(detail::saturating_mul_pow2(1, e));
+  }
+
+  /**
+   * Returns the engine at the beginning of the `k`-th of `n` non-overlapping
+   * substreams that start from the current state.
+   *
+   * The `k`-th substream starts `k` * 2^`e` steps ahead, where `e` is 127
+   * minus the number of bits of `n`, so each substream has at least
+   * 2^126 / `n` numbers. The jump uses the same table as `advance_pow2()`.
+   *
+   * @param k index of the substream, must be less than `n`
+   * @param n number of substreams, must be positive
+   * @return engine for the substream
+   * @throw std::domain_error if the parameter set does not give the maximal
+   * period 2^127-1
+   */
+  tinymt_engine split(std::uint_least64_t k, std::uint_least64_t n) const {
+    std::size_t bits = 0;
+    for (; n != 0; n >>= 1) {
+      bits++;
+    }
+    tinymt_engine e = *this;
+    impl::discard_pow2(e.s_, k, detail::tinymt_mexp - bits);
+    e.on_discard(detail::saturating_mul_pow2(k, detail::tinymt_mexp - bits));
+    return e;
+  }
+
+  /**
+   * Returns the smallest possible value in the output range.
+   *
+   * @return smallest value
+   */
+  static constexpr result_type min() { return 0; }
+
+  /**
+   * Returns the largest possible value in the output range.
+   *
+   * @return largest value
+   */
+  static constexpr result_type max() { return impl::max; }
+
+  /**
+   * Returns the next pseudo-random number.
+   *
+   * @return generated value
+   */
+  TINYMT_CPP_CONSTEXPR result_type operator()() {
+    this->on_draw(1);
+    impl::next_state(s_);
+    return impl::temper(s_);
+  }
+
+  /**
+   * Fills the given range with pseudo-random numbers. Equivalent to assigning
+   * the results of successive calls of `operator()` but faster.
+   *
+   * @param first beginning of the range
+   * @param last  end of the range
+   */
+  template <class ForwardIt>
+  TINYMT_CPP_CONSTEXPR void generate(ForwardIt first, ForwardIt last) {
+    count_fill(first, last);
+    impl::generate(s_, first, last);
+  }
+
+  /**
+   * Fills the given array with pseudo-random numbers. Equivalent to
+   * `generate(p, p + n)`.
+   *
+   * @param p pointer to the first element of the array
+   * @param n number of elements
+   */
+  template <class T>
+  TINYMT_CPP_CONSTEXPR void fill(T* p, std::size_t n) {
+    static_assert(std::is_integral<T>::value && std::is_unsigned<T>::value &&
+                      std::numeric_limits<T>::digits >= word_size,
+                  "T must be an unsigned integral type of at least word_size");
+    this->on_fill(n);
+    impl::generate(s_, p, p + n);
+  }
+
+  /**
+   * Fills the given array with the results of `op` applied to pseudo-random
+   * numbers. Equivalent to assigning `op((*this)())` to `p[0]`, ..., `p[n - 1]`
+   * in this order.
+   *
+   * For large arrays of TinyMT32, the array is divided into parts whose
+   * starting states are obtained by jumps, and the parts are generated together
+   * by SIMD instructions. The results are the same.
+   *
+   * @param p  pointer to the first element of the array
+   * @param n  number of elements
+   * @param op function object converting a generated value into `T`
+   */
+  template <class T, class UnaryOp>
+  void generate_transform(T* p, std::size_t n, UnaryOp op) {
+    this->on_fill(n);
+    impl::generate_transform(s_, p, n, op);
+  }
+
+  /**
+   * Returns the next pseudo-random number as a float in [0, 1), obtained by
+   * multiplying the upper 24 bits by 2^-24. TinyMT32 only.
+   *
+   * @return generated value
+   */
+  template <TINYMT_CPP_ENABLE_WHEN(word_size == 32)>
+  float generate_float() {
+    return static_cast<float>((*this)() >> 8) * (1.0f / 16777216.0f);
+  }
+
+  /**
+   * Returns the next pseudo-random number as a float in [1, 2), whose mantissa
+   * is directly taken from the upper 23 bits. TinyMT32 only.
+   *
+   * @return generated value
+   */
+  template <TINYMT_CPP_ENABLE_WHEN(word_size == 32)>
+  float generate_float12() {
+    return detail::make_float12<float>(
+        static_cast<std::uint_least32_t>((*this)() >> 9));
+  }
+
+  /**
+   * Returns the next pseudo-random number as a float in [0, 1), whose mantissa
+   * is directly taken from the upper 23 bits. TinyMT32 only.
+   *
+   * @return generated value
+   */
+  template <TINYMT_CPP_ENABLE_WHEN(word_size == 32)>
+  float generate_float01() {
+    return generate_float12() - 1.0f;
+  }
+
+  /**
+   * Returns the next pseudo-random number as a float in (0, 1], whose mantissa
+   * is directly taken from the upper 23 bits. TinyMT32 only.
+   *
+   * @return generated value
+   */
+  template <TINYMT_CPP_ENABLE_WHEN(word_size == 32)>
+  float generate_floatOC() {
+    return 1.0f - generate_float01();
+  }
+
+  /**
+   * Returns the next pseudo-random number as a float in (0, 1), whose mantissa
+   * is directly taken from the upper 22 bits with the lowest bit set. TinyMT32
+   * only.
+   *
+   * @return generated value
+   */
+  template <TINYMT_CPP_ENABLE_WHEN(word_size == 32)>
+  float generate_floatOO() {
+    return detail::make_float12<float>(
+               static_cast<std::uint_least32_t>(((*this)() >> 9) | 1)) -
+           1.0f;
+  }
+
+  /**
+   * Returns the next pseudo-random number as a double in [0, 1), obtained by
+   * multiplying the 32-bit output by 2^-32. TinyMT32 only.
+   *
+   * @return generated value
+   */
+  template <TINYMT_CPP_ENABLE_WHEN(word_size == 32)>
+  double generate_32double() {
+    return static_cast<double>((*this)()) * (1.0 / 4294967296.0);
+  }
+
+  /**
+   * Returns the next pseudo-random number as a double in [0, 1), obtained by
+   * multiplying the upper 53 bits by 2^-53. TinyMT64 only.
+   *
+   * @return generated value
+   */
+  template <TINYMT_CPP_ENABLE_WHEN(word_size == 64)>
+  double generate_double() {
+    return static_cast<double>((*this)() >> 11) * (1.0 / 9007199254740992.0);
+  }
+
+  /**
+   * Returns the next pseudo-random number as a double in [1, 2), whose mantissa
+   * is directly taken from the upper 52 bits. TinyMT64 only.
+   *
+   * @return generated value
+   */
+  template <TINYMT_CPP_ENABLE_WHEN(word_size == 64)>
+  double generate_double12() {
+    return detail::make_float12<double>(
+        static_cast<std::uint_least64_t>((*this)() >> 12));
+  }
+
+  /**
+   * Returns the next pseudo-random number as a double in [0, 1), whose
+   * mantissa is directly taken from the upper 52 bits. TinyMT64 only.
+   *
+   * @return generated value
+   */
+  template <TINYMT_CPP_ENABLE_WHEN(word_size == 64)>
+  double generate_double01() {
+    return generate_double12() - 1.0;
+  }
+
+  /**
+   * Returns the next pseudo-random number as a double in (0, 1], whose
+   * mantissa is directly taken from the upper 52 bits. TinyMT64 only.
+   *
+   * @return generated value
+   */
+  template <TINYMT_CPP_ENABLE_WHEN(word_size == 64)>
+  double generate_doubleOC() {
+    return 2.0 - generate_double12();
+  }
+
+  /**
+   * Returns the next pseudo-random number as a double in (0, 1), whose
+   * mantissa is directly taken from the upper 51 bits with the lowest bit set.
+   * TinyMT64 only.
+   *
+   * @return generated value
+   */
+  template <TINYMT_CPP_ENABLE_WHEN(word_size == 64)>
+  double generate_doubleOO() {
+    return detail::make_float12<double>(
+               static_cast<std::uint_least64_t>(((*this)() >> 12) | 1)) -
+           1.0;
+  }
+
+  /**
+   * Returns the counter policy object of the engine, e.g., `engine_counter`
+   * with `counts()`.
+   *
+   * @return counter
+   */
+  const Counter& counter() const { return *this; }
+
+  /**
+   * Returns the counter policy object of the engine.
+   *
+   * @return counter
+   */
+  Counter& counter() { return *this; }
+
+  /**
+   * Compares two engines. The counters are not compared.
+   *
+   * @param a first engine
+   * @param b second engine
+   * @return `true` if the engines are equivalent including their internal
+   * states, `false` otherwise
+   */
+  friend bool operator==(const tinymt_engine& a, const tinymt_engine& b) {
+    return a.s_ == b.s_;
+  }
+
+  /**
+   * Compares two engines.
+   *
+   * @param a first engine
+   * @param b second engine
+   * @return `true` if the engines are not equivalent including their internal
+   * states, `false` otherwise
+   */
+  friend bool operator!=(const tinymt_engine& a, const tinymt_engine& b) {
+    return a.s_ != b.s_;
+  }
+
+  /**
+   * Serializes the state of the given engine into a stream.
+   *
+   * @param os output stream
+   * @param e  engine to be serialized
+   * @return `os`
+   */
+  template <class CharT, class Traits>
+  friend std::basic_ostream<CharT, Traits>& operator<<(
+      std::basic_ostream<CharT, Traits>& os, const tinymt_engine& e) {
+    return os << e.s_;
+  }
+
+  /**
+   * Deserializes the state of the given engine from a stream.
+   *
+   * @param is input stream
+   * @param e  engine to be deserialized
+   * @return `is`
+   */
+  template <class CharT, class Traits>
+  friend std::basic_istream<CharT, Traits>& operator>>(
+      std::basic_istream<CharT, Traits>& is, tinymt_engine& e) {
+    return is >> e.s_;
+  }
+
+  /**
+   * Saves the state of the engine in the binary form of `serialized_size`
+   * bytes, in little-endian byte order independently of the platform.
+   *
+   * @param out pointer to a buffer of at least `serialized_size` bytes
+   */
+  void save(unsigned char* out) const { serializer::save(s_, out); }
+
+  /**
+   * Restores the state of the engine saved by `save()`.
+   *
+   * @param in pointer to `serialized_size` bytes
+   */
+  void load(const unsigned char* in) { serializer::load(s_, in); }
+
+  /**
+   * Writes the state of the engine in the same text form as `operator<<`,
+   * without locales or memory allocation.
+   *
+   * @param first beginning of the output buffer
+   * @param last  end of the output buffer
+   * @return end of the written characters, or `nullptr` if the buffer is too
+   * small, which never happens for a buffer of `max_chars` characters
+   */
+  char* to_chars(char* first, char* last) const {
+    return serializer::to_chars(s_, first, last);
+  }
+
+  /**
+   * Reads the state of the engine in the text form written by `to_chars()` or
+   * `operator<<`, skipping leading whitespace. The engine is unchanged on
+   * error.
+   *
+   * @param first beginning of the input
+   * @param last  end of the input
+   * @return end of the read characters, or `nullptr` on error
+   */
+  const char* from_chars(const char* first, const char* last) {
+    return serializer::from_chars(s_, first, last);
+  }
+
+ private:
+  template <class U, std::size_t W, U M1, U M2, U T, bool C, class OtherCounter>
+  friend class tinymt_engine;
+
+  template <class ForwardIt,
+            TINYMT_CPP_ENABLE_WHEN(std::is_same<Counter, no_counter>::value)>
+  TINYMT_CPP_CONSTEXPR void count_fill(ForwardIt, ForwardIt) {}
+
+  // Not for no_counter: std::distance may walk through the range.
+  template <class ForwardIt,
+            TINYMT_CPP_ENABLE_WHEN(!std::is_same<Counter, no_counter>::value)>
+  TINYMT_CPP_CONSTEXPR void count_fill(ForwardIt first, ForwardIt last) {
+    this->on_fill(
+        static_cast<std::uint_least64_t>(std::distance(first, last)));
+  }
+};
+
+/**
+ * TinyMT32 generator engine with the parameter set specified in RFC 8682.
+ */
+using tinymt32 =
+    tinymt_engine<uint_fast32_t, 32, detail::tinymt32_default_param_mat1,
+                  detail::tinymt32_default_param_mat2,
+                  detail::tinymt32_default_param_tmat, false>;
+
+/**
+ * TinyMT32 generator engine with "Dynamic Creation" of its parameter set.
+ */
+using tinymt32_dc = tinymt_engine<uint_fast32_t, 32, 0, 0, 0, true>;
+
+/**
+ * TinyMT64 generator engine with the parameter set of the reference
+ * implementation.
+ */
+using tinymt64 =
+    tinymt_engine<uint_fast64_t, 64, detail::tinymt64_default_param_mat1,
+                  detail::tinymt64_default_param_mat2,
+                  detail::tinymt64_default_param_tmat, true>;
+
+/**
+ * TinyMT64 generator engine with "Dynamic Creation" of its parameter set.
+ */
+using tinymt64_dc = tinymt_engine<uint_fast64_t, 64, 0, 0, 0, true>;
+
+/**
+ * `tinymt32` with a counter policy.
+ *
+ * @tparam Counter counter policy
+ */
+template <class Counter = engine_counter>
+using tinymt32_counted =
+    tinymt_engine<uint_fast32_t, 32, detail::tinymt32_default_param_mat1,
+                  detail::tinymt32_default_param_mat2,
+                  detail::tinymt32_default_param_tmat, false, Counter>;
+
+/**
+ * `tinymt32_dc` with a counter policy.
+ *
+ * @tparam Counter counter policy
+ */
+template <class Counter = engine_counter>
+using tinymt32_dc_counted =
+    tinymt_engine<uint_fast32_t, 32, 0, 0, 0, true, Counter>;
+
+/**
+ * `tinymt64` with a counter policy.
+ *
+ * @tparam Counter counter policy
+ */
+template <class Counter = engine_counter>
+using tinymt64_counted =
+    tinymt_engine<uint_fast64_t, 64, detail::tinymt64_default_param_mat1,
+                  detail::tinymt64_default_param_mat2,
+                  detail::tinymt64_default_param_tmat, true, Counter>;
+
+/**
+ * `tinymt64_dc` with a counter policy.
+ *
+ * @tparam Counter counter policy
+ */
+template <class Counter = engine_counter>
+using tinymt64_dc_counted =
+    tinymt_engine<uint_fast64_t, 64, 0, 0, 0, true, Counter>;
+
+// The states are packed in the words of the generators, independently of the
+// result types.
+static_assert(sizeof(tinymt32) == 4 * sizeof(std::uint_least32_t),
+              "tinymt32 must consist of 4 words");
+static_assert(sizeof(tinymt32_dc) == 7 * sizeof(std::uint_least32_t),
+              "tinymt32_dc must consist of 7 words");
+static_assert(sizeof(tinymt64) == 2 * sizeof(std::uint_least64_t),
+              "tinymt64 must consist of 2 words");
+
+/**
+ * Array of independent generators in DC mode, stored in the structure-of-arrays
+ * layout so that all the lanes are stepped together by SIMD instructions.
+ *
+ * Lane `i` generates the same sequence as the `tinymt_engine` in DC mode
+ * constructed with the same parameter set and seed.
+ *
+ * @tparam UIntType unsigned integral type generated by the engine
+ * @tparam WordSize word size for the generated numbers
+ * @tparam Lanes    number of lanes
+ * @tparam DoPeriodCertification whether or not period certification is
+ * performed in initialization
+ *
+ * @note Currently `WordSize` must be `32`.
+ * @note `fill()` chooses the kernel for AVX-512, AVX2 or the target of the
+ * compilation by the features of the CPU at its first call, see
+ * `TINYMT_CPP_USE_TARGET_CLONES`.
+ */
+template <class UIntType, std::size_t WordSize, std::size_t Lanes,
+          bool DoPeriodCertification = true>
+class tinymt_engine_array {
+  static_assert(WordSize == 32, "word_size must be 32");
+  static_assert(Lanes > 0, "Lanes must be positive");
+
+  using impl = detail::tinymt_engine_impl<UIntType, WordSize, 0, 0, 0,
+                                          DoPeriodCertification>;
+  using status_type = detail::tinymt_engine_status<UIntType, WordSize, 0, 0, 0>;
+  using kernel = detail::tinymt32_lanes<Lanes>;
+  using word_type = typename kernel::word_type;
+  using lane_words = typename kernel::lane_words;
+
+  struct lanes_status {
+    typename kernel::status_words status;
+    lane_words mat1;
+    lane_words mat2;
+    lane_words tmat;
+  };
+
+  lanes_status s_;
+
+  status_type load(std::size_t lane) const {
+    status_type t;
+    for (std::size_t j = 0; j < state_size; j++) {
+      t.status[j] = s_.status[j][lane];
+    }
+    t.mat1 = s_.mat1[lane];
+    t.mat2 = s_.mat2[lane];
+    t.tmat = s_.tmat[lane];
+    return t;
+  }
+
+  void store(std::size_t lane, const status_type& t) {
+    for (std::size_t j = 0; j < state_size; j++) {
+      s_.status[j][lane] = static_cast<word_type>(t.status[j]);
+    }
+    s_.mat1[lane] = static_cast<word_type>(t.mat1);
+    s_.mat2[lane] = static_cast<word_type>(t.mat2);
+    s_.tmat[lane] = static_cast<word_type>(t.tmat);
+  }
+
+  static void next_state(lanes_status& s) {
+    kernel::next_state(s.status, s.mat1, s.mat2);
+  }
+
+  template <class T>
+  static void temper(const lanes_status& s, T* p) {
+    kernel::temper(s.status, s.tmat, p);
+  }
+
+ public:
+  /**
+   * Integral type generated by the engine.
+   */
+  using result_type = UIntType;
+
+  /**
+   * Type of the generator parameter set.
+   */
+  using param_type = typename impl::param_type;
+
+  /**
+   * Word size that determines the range of numbers generated by the engine.
+   */
+  static constexpr std::size_t word_size = WordSize;
+
+  /**
+   * Size of the state of each lane in words.
+   */
+  static constexpr std::size_t state_size = impl::state_size;
+
+  /**
+   * Number of lanes.
+   */
+  static constexpr std::size_t lanes = Lanes;
+
+  /**
+   * Default seed.
+   */
+  static constexpr result_type default_seed = 1;
+
+  /**
+   * Constructs the engines with the same parameter set and seed for all the
+   * lanes.
+   *
+   * @param param parameter set
+   * @param seed random seed
+   */
+  explicit tinymt_engine_array(const param_type& param,
+                               result_type seed = default_seed) {
+    for (std::size_t i = 0; i < Lanes; i++) {
+      this->seed(i, param, seed);
+    }
+  }
+
+  /**
+   * Constructs the engines with a parameter set and a seed for each lane.
+   *
+   * @param params parameter sets
+   * @param seeds random seeds
+   */
+  tinymt_engine_array(const std::array<param_type, Lanes>& params,
+                      const std::array<result_type, Lanes>& seeds) {
+    for (std::size_t i = 0; i < Lanes; i++) {
+      seed(i, params[i], seeds[i]);
+    }
+  }
+
+  /**
+   * Reinitializes one lane.
+   *
+   * @param lane  index of the lane
+   * @param param parameter set
+   * @param value random seed
+   */
+  void seed(std::size_t lane, const param_type& param,
+            result_type value = default_seed) {
+    status_type t;
+    t.mat1 = static_cast<word_type>(param.mat1 & impl::word_mask);
+    t.mat2 = static_cast<word_type>(param.mat2 & impl::word_mask);
+    t.tmat = static_cast<word_type>(param.tmat & impl::word_mask);
+    impl::init(t, value);
+    store(lane, t);
+  }
+
+  /**
+   * Advances the state of all the lanes by the given amount.
+   *
+   * @param z number of advances
+   */
+  void discard(unsigned long long z) {  // NOLINT
+    for (std::size_t i = 0; i < Lanes; i++) {
+      status_type t = load(i);
+      impl::discard(t, z);
+      store(i, t);
+    }
+  }
+
+  /**
+   * Returns the smallest possible value in the output range.
+   *
+   * @return smallest value
+   */
+  static constexpr result_type min() { return 0; }
+
+  /**
+   * Returns the largest possible value in the output range.
+   *
+   * @return largest value
+   */
+  static constexpr result_type max() { return impl::max; }
+
+  /**
+   * Returns the next pseudo-random number of each lane.
+   *
+   * @return generated values, one per lane
+   */
+  std::array<result_type, Lanes> operator()() {
+    std::array<result_type, Lanes> x;
+    next_state(s_);
+    temper(s_, x.data());
+    return x;
+  }
+
+  /**
+   * Fills the given array with pseudo-random numbers in the lane-interleaved
+   * order: `p[k]` is taken from lane `k % lanes`. When `n` is not a multiple
+   * of `lanes`, the outputs of the last step of the remaining lanes are
+   * discarded, such that all the lanes are always advanced together.
+   *
+   * @param p pointer to the first element of the array
+   * @param n number of elements
+   */
+  template <class T>
+  void fill(T* p, std::size_t n) {
+    static_assert(std::is_integral<T>::value && std::is_unsigned<T>::value &&
+                      std::numeric_limits<T>::digits >= word_size,
+                  "T must be an unsigned integral type of at least word_size");
+
+    // Work on a local copy, which cannot alias the output.
+    lanes_status t = s_;
+    const std::size_t steps = n / Lanes;
+    kernel::generate(t.status, t.mat1, t.mat2, t.tmat, p, steps);
+    p += steps * Lanes;
+    n -= steps * Lanes;
+    if (n > 0) {
+      T x[Lanes];
+      next_state(t);
+      temper(t, x);
+      for (std::size_t i = 0; i < n; i++) {
+        p[i] = x[i];
+      }
+    }
+    s_ = t;
+  }
+
+  /**
+   * Compares two engine arrays.
+   *
+   * @param a first engine array
+   * @param b second engine array
+   * @return `true` if all the lanes are equivalent including their internal
+   * states, `false` otherwise
+   */
+  friend bool operator==(const tinymt_engine_array& a,
+                         const tinymt_engine_array& b) {
+    return a.s_.status == b.s_.status && a.s_.mat1 == b.s_.mat1 &&
+           a.s_.mat2 == b.s_.mat2 && a.s_.tmat == b.s_.tmat;
+  }
+
+  /**
+   * Compares two engine arrays.
+   *
+   * @param a first engine array
+   * @param b second engine array
+   * @return `true` if any of the lanes are not equivalent including their
+   * internal states, `false` otherwise
+   */
+  friend bool operator!=(const tinymt_engine_array& a,
+                         const tinymt_engine_array& b) {
+    return !(a == b);
+  }
+};
+
+/**
+ * Array of `Lanes` TinyMT32 generator engines with "Dynamic Creation" of their
+ * parameter sets, stepped together.
+ */
+template <std::size_t Lanes>
+using tinymt32_dc_array = tinymt_engine_array<uint_fast32_t, 32, Lanes, true>;
+
+/**
+ * TinyMT generator engine with "Dynamic Creation" of its parameter set, which
+ * refers to a parameter set in a shared table by an index instead of holding
+ * a copy. An engine of TinyMT32 takes 20 bytes instead of 28, and engines
+ * sharing a few parameter sets keep them hot in the cache.
+ *
+ * It generates the same sequence as the `tinymt_engine` in DC mode
+ * constructed with the parameter set and the same seed.
+ *
+ * `ParamTable` must have a static member function `get(std::size_t index)`
+ * returning the parameter set of the given index, e.g., a reference to an
+ * element of a static array:
+ *
+ * @code
+ * struct my_params {
+ *   static const tinymt::tinymt32_dc::param_type& get(std::size_t i) {
+ *     static const tinymt::tinymt32_dc::param_type table[] = {...};
+ *     return table[i];
+ *   }
+ * };
+ * using engine = tinymt::tinymt32_shared_dc<my_params>;
+ * @endcode
+ *
+ * The table must not change while engines refer to it.
+ *
+ * @tparam UIntType   unsigned integral type generated by the engine
+ * @tparam WordSize   word size for the generated numbers
+ * @tparam ParamTable table of parameter sets
+ * @tparam DoPeriodCertification whether or not period certification is
+ * performed in initialization
+ */
+template <class UIntType, std::size_t WordSize, class ParamTable,
+          bool DoPeriodCertification = true>
+class tinymt_engine_shared {
+  static_assert(std::is_integral<UIntType>::value &&
+                    std::is_unsigned<UIntType>::value,
+                "result_type must be an unsigned integral type");
+  static_assert(WordSize == 32 || WordSize == 64, "word_size must be 32 or 64");
+
+  using impl = detail::tinymt_engine_impl<UIntType, WordSize, 0, 0, 0,
+                                          DoPeriodCertification>;
+  using status_type = detail::tinymt_engine_status<UIntType, WordSize, 0, 0, 0>;
+  using word_type = typename status_type::word_type;
+
+  std::array<word_type, impl::state_size> status_;
+  std::uint_least32_t index_;
+
+ public:
+  /**
+   * Integral type generated by the engine.
+   */
+  using result_type = UIntType;
+
+  /**
+   * Type of the generator parameter set.
+   */
+  using param_type = typename impl::param_type;
+
+  /**
+   * Type of the table of parameter sets.
+   */
+  using table_type = ParamTable;
+
+  /**
+   * Word size that determines the range of numbers generated by the engine.
+   */
+  static constexpr std::size_t word_size = WordSize;
+
+  /**
+   * Size of the state of the generator in words.
+   */
+  static constexpr std::size_t state_size = impl::state_size;
+
+  /**
+   * Default seed.
+   */
+  static constexpr result_type default_seed = 1;
+
+  /**
+   * Constructs the engine with the parameter set of the given index.
+   *
+   * @param index index of the parameter set in the table, must be < 2^32
+   * @param seed  random seed
+   */
+  explicit tinymt_engine_shared(std::size_t index,
+                                result_type seed = default_seed)
+      : status_(), index_(static_cast<std::uint_least32_t>(index)) {
+    status_type s = load();
+    impl::init(s, seed);
+    status_ = s.status;
+  }
+
+  /**
+   * Reinitializes the engine.
+   *
+   * @param value random seed
+   */
+  void seed(result_type value = default_seed) {
+    status_type s = load();
+    impl::init(s, value);
+    status_ = s.status;
+  }
+
+  /**
+   * Advances the state of the engine by the given amount.
+   *
+   * @param z number of advances
+   */
+  void discard(unsigned long long z) {  // NOLINT
+    status_type s = load();
+    impl::discard(s, z);
+    status_ = s.status;
+  }
+
+  /**
+   * Returns the smallest possible value in the output range.
+   *
+   * @return smallest value
+   */
+  static constexpr result_type min() { return 0; }
+
+  /**
+   * Returns the largest possible value in the output range.
+   *
+   * @return largest value
+   */
+  static constexpr result_type max() { return impl::max; }
+
+  /**
+   * Returns the next pseudo-random number.
+   *
+   * @return generated value
+   */
+  result_type operator()() {
+    status_type s = load();
+    impl::next_state(s);
+    status_ = s.status;
+    return impl::temper(s);
+  }
+
+  /**
+   * Fills the given range with pseudo-random numbers. Equivalent to assigning
+   * the results of successive calls of `operator()` but faster.
+   *
+   * @param first beginning of the range
+   * @param last  end of the range
+   */
+  template <class ForwardIt>
+  void generate(ForwardIt first, ForwardIt last) {
+    status_type s = load();
+    impl::generate(s, first, last);
+    status_ = s.status;
+  }
+
+  /**
+   * Returns the index of the parameter set in the table.
+   *
+   * @return index
+   */
+  std::size_t index() const { return index_; }
+
+  /**
+   * Returns the parameter set.
+   *
+   * @return parameter set
+   */
+  param_type param() const {
+    const status_type s = load();
+    return param_type{s.mat1, s.mat2, s.tmat};
+  }
+
+  /**
+   * Compares two engines.
+   *
+   * @param a first engine
+   * @param b second engine
+   * @return `true` if the engines have the same parameter set and state,
+   * `false` otherwise
+   */
+  friend bool operator==(const tinymt_engine_shared& a,
+                         const tinymt_engine_shared& b) {
+    return a.load() == b.load();
+  }
+
+  /**
+   * Compares two engines.
+   *
+   * @param a first engine
+   * @param b second engine
+   * @return `true` if the engines have different parameter sets or states,
+   * `false` otherwise
+   */
+  friend bool operator!=(const tinymt_engine_shared& a,
+                         const tinymt_engine_shared& b) {
+    return !(a == b);
+  }
+
+ private:
+  // The state with a copy of the parameter set, as the implementation works
+  // on it. The copy stays in registers when inlined.
+  status_type load() const {
+    const auto& p = ParamTable::get(index_);
+    status_type s;
+    s.status = status_;
+    s.mat1 = static_cast<word_type>(p.mat1 & impl::mat_mask);
+    s.mat2 = static_cast<word_type>(p.mat2 & impl::mat_mask);
+    s.tmat = static_cast<word_type>(p.tmat & impl::word_mask);
+    return s;
+  }
+};
 
-  static void period_certification(status_type& s) {
-    // In theory, this may happen but I don't know any example, so it is too
-    // difficult to cover these lines.
+/**
+ * TinyMT32 generator engine with "Dynamic Creation" of its parameter set,
+ * referring to a parameter set in the shared table `ParamTable` by an index.
+ */
+template <class ParamTable>
+using tinymt32_shared_dc =
+    tinymt_engine_shared<uint_fast32_t, 32, ParamTable, true>;
 
-    // LCOV_EXCL_START
-    if ((s.status[0] & mask) == 0 && s.status[1] == 0 && s.status[2] == 0 &&
-        s.status[3] == 0) {
-      s.status[0] = 'T';
-      s.status[1] = 'I';
-      s.status[2] = 'N';
-      s.status[3] = 'Y';
+/**
+ * Engine adaptor that generates the outputs of the wrapped engine in blocks,
+ * so that `operator()` is just a load from the buffer most of the time. This
+ * keeps the state transition out of the code that calls the engine.
+ *
+ * It generates the same sequence as the wrapped engine, and `discard()` and
+ * the comparison operators behave as if on the wrapped engine.
+ *
+ * @tparam Engine    engine type, e.g., `tinymt32`
+ * @tparam BlockSize number of outputs generated at once
+ */
+template <class Engine, std::size_t BlockSize = 256>
+class buffered_engine {
+  static_assert(BlockSize > 0, "BlockSize must be positive");
+
+ public:
+  /**
+   * Type of the wrapped engine.
+   */
+  using engine_type = Engine;
+
+  /**
+   * Integral type generated by the engine.
+   */
+  using result_type = typename Engine::result_type;
+
+  /**
+   * Number of outputs generated at once.
+   */
+  static constexpr std::size_t block_size = BlockSize;
+
+  /**
+   * Constructs the engine with a default-constructed engine.
+   */
+  buffered_engine() : buf_(), e_(), pos_(BlockSize) {}
+
+  /**
+   * Constructs the engine with a copy of the given engine.
+   *
+   * @param e engine
+   */
+  explicit buffered_engine(const Engine& e) : buf_(), e_(e), pos_(BlockSize) {}
+
+  /**
+   * Constructs the engine with an engine constructed from the given seed.
+   *
+   * @param seed random seed
+   */
+  explicit buffered_engine(result_type seed)
+      : buf_(), e_(seed), pos_(BlockSize) {}
+
+  /**
+   * Reinitializes the wrapped engine and discards the buffered outputs.
+   *
+   * @param value random seed
+   */
+  void seed(result_type value = Engine::default_seed) {
+    e_.seed(value);
+    pos_ = BlockSize;
+  }
+
+  /**
+   * Advances the state of the engine by the given amount.
+   *
+   * @param z number of advances
+   */
+  void discard(unsigned long long z) {  // NOLINT
+    const std::size_t left = BlockSize - pos_;
+    if (z <= left) {
+      pos_ += static_cast<std::size_t>(z);
+    } else {
+      e_.discard(z - left);
+      pos_ = BlockSize;
     }
-    // LCOV_EXCL_STOP
   }
 
-  static void init(status_type& s, result_type seed) {
-    const unsigned int MIN_LOOP = 8;
-    const unsigned int PRE_LOOP = 8;
+  /**
+   * Returns the smallest possible value in the output range.
+   *
+   * @return smallest value
+   */
+  static constexpr result_type min() { return Engine::min(); }
+
+  /**
+   * Returns the largest possible value in the output range.
+   *
+   * @return largest value
+   */
+  static constexpr result_type max() { return Engine::max(); }
+
+  /**
+   * Returns the next pseudo-random number.
+   *
+   * @return generated value
+   */
+  result_type operator()() {
+    if (pos_ == BlockSize) {
+      refill();
+    }
+    return buf_[pos_++];
+  }
+
+  /**
+   * Compares two engines.
+   *
+   * @param a first engine
+   * @param b second engine
+   * @return `true` if the engines generate the same sequence from now on,
+   * `false` otherwise
+   */
+  friend bool operator==(const buffered_engine& a, const buffered_engine& b) {
+    // The wrapped engines are ahead by the numbers of the buffered outputs.
+    const std::size_t left_a = BlockSize - a.pos_;
+    const std::size_t left_b = BlockSize - b.pos_;
+    if (left_a == left_b) {
+      return a.e_ == b.e_;
+    }
+    if (left_a > left_b) {
+      Engine e = b.e_;
+      e.discard(left_a - left_b);
+      return e == a.e_;
+    }
+    Engine e = a.e_;
+    e.discard(left_b - left_a);
+    return e == b.e_;
+  }
+
+  /**
+   * Compares two engines.
+   *
+   * @param a first engine
+   * @param b second engine
+   * @return `true` if the engines generate different sequences from now on,
+   * `false` otherwise
+   */
+  friend bool operator!=(const buffered_engine& a, const buffered_engine& b) {
+    return !(a == b);
+  }
+
+ private:
+  // Not over-aligned, so that new and std::vector work before C++17.
+  std::array<result_type, BlockSize> buf_;
+  Engine e_;
+  // Index of the next output in buf_; BlockSize if empty.
+  std::size_t pos_;
+
+  void refill() {
+    e_.generate(buf_.begin(), buf_.end());
+    pos_ = 0;
+  }
+};
+
+/**
+ * Produces random integers uniformly distributed on the closed interval
+ * [a, b], by Lemire's nearly divisionless method.
+ *
+ * Unlike `std::uniform_int_distribution`, the results are specified: each value
+ * is taken from the upper bits of the product of a 32-bit word and the range
+ * size (64-bit words for ranges larger than 2^32), with rare rejections. The
+ * generator must generate full 32-bit or 64-bit words, like the engines in
+ * this library; the upper half of the output is used for 32-bit words of a
+ * 64-bit engine.
+ *
+ * @tparam IntType integral type of the results
+ */
+template <class IntType = int>
+class uniform_int {
+  static_assert(std::is_integral<IntType>::value,
+                "result_type must be an integral type");
+
+  using unsigned_type = typename std::make_unsigned<IntType>::type;
+
+ public:
+  /**
+   * Integral type of the results.
+   */
+  using result_type = IntType;
+
+  /**
+   * Type of the distribution parameters.
+   */
+  class param_type {
+    result_type a_;
+    result_type b_;
+
+   public:
+    /**
+     * Type of the distribution.
+     */
+    using distribution_type = uniform_int;
+
+    /**
+     * Constructs the parameters.
+     *
+     * @param a lower bound
+     * @param b upper bound, must be `a <= b`
+     */
+    explicit param_type(result_type a = 0,
+                        result_type b = std::numeric_limits<result_type>::max())
+        : a_(a), b_(b) {}
+
+    /**
+     * Returns the lower bound.
+     *
+     * @return lower bound
+     */
+    result_type a() const { return a_; }
+
+    /**
+     * Returns the upper bound.
+     *
+     * @return upper bound
+     */
+    result_type b() const { return b_; }
+
+    /**
+     * Compares two parameter sets.
+     *
+     * @param x first parameter set
+     * @param y second parameter set
+     * @return `true` if they are equal, `false` otherwise
+     */
+    friend bool operator==(const param_type& x, const param_type& y) {
+      return x.a_ == y.a_ && x.b_ == y.b_;
+    }
+
+    /**
+     * Compares two parameter sets.
+     *
+     * @param x first parameter set
+     * @param y second parameter set
+     * @return `true` if they are not equal, `false` otherwise
+     */
+    friend bool operator!=(const param_type& x, const param_type& y) {
+      return !(x == y);
+    }
+  };
+
+  /**
+   * Constructs the distribution.
+   *
+   * @param a lower bound
+   * @param b upper bound, must be `a <= b`
+   */
+  explicit uniform_int(result_type a = 0,
+                       result_type b = std::numeric_limits<result_type>::max())
+      : p_(a, b) {}
+
+  /**
+   * Constructs the distribution.
+   *
+   * @param p distribution parameters
+   */
+  explicit uniform_int(const param_type& p) : p_(p) {}
+
+  /**
+   * Resets the internal state. This distribution has no internal state.
+   */
+  void reset() {}
+
+  /**
+   * Returns the lower bound.
+   *
+   * @return lower bound
+   */
+  result_type a() const { return p_.a(); }
+
+  /**
+   * Returns the upper bound.
+   *
+   * @return upper bound
+   */
+  result_type b() const { return p_.b(); }
+
+  /**
+   * Returns the distribution parameters.
+   *
+   * @return distribution parameters
+   */
+  param_type param() const { return p_; }
+
+  /**
+   * Sets the distribution parameters.
+   *
+   * @param p distribution parameters
+   */
+  void param(const param_type& p) { p_ = p; }
+
+  /**
+   * Returns the smallest possible value.
+   *
+   * @return smallest value
+   */
+  result_type min() const { return a(); }
+
+  /**
+   * Returns the largest possible value.
+   *
+   * @return largest value
+   */
+  result_type max() const { return b(); }
+
+  /**
+   * Generates the next random number.
+   *
+   * @param g uniform random bit generator
+   * @return generated value
+   */
+  template <class URBG>
+  result_type operator()(URBG& g) {
+    return (*this)(g, p_);
+  }
+
+  /**
+   * Generates the next random number with the given parameters.
+   *
+   * @param g uniform random bit generator
+   * @param p distribution parameters
+   * @return generated value
+   */
+  template <class URBG>
+  result_type operator()(URBG& g, const param_type& p) {
+    static_assert(detail::is_word_generator<URBG>::value,
+                  "URBG must generate full 32-bit or 64-bit words");
+
+    return detail::add_offset(p.a(), offset(g, range(p)));
+  }
+
+  /**
+   * Fills the given range with random numbers. The results and the final state
+   * of the generator are the same as successive calls of `operator()`, but the
+   * words are taken from the generator in bulk when it supports
+   * `generate(first, last)`.
+   *
+   * @param first beginning of the range
+   * @param last  end of the range
+   * @param g     uniform random bit generator
+   */
+  template <class ForwardIt, class URBG>
+  void generate(ForwardIt first, ForwardIt last, URBG& g) {
+    static_assert(detail::is_word_generator<URBG>::value,
+                  "URBG must generate full 32-bit or 64-bit words");
+
+    using value_type = typename std::iterator_traits<ForwardIt>::value_type;
+
+    detail::word_buffer<URBG> words(
+        g, static_cast<std::size_t>(std::distance(first, last)));
+    for (; first != last; ++first) {
+      *first = static_cast<value_type>(
+          detail::add_offset(p_.a(), offset(words, range(p_))));
+      words.finish_one();
+    }
+  }
+
+  /**
+   * Compares two distributions.
+   *
+   * @param x first distribution
+   * @param y second distribution
+   * @return `true` if they have the same parameters, `false` otherwise
+   */
+  friend bool operator==(const uniform_int& x, const uniform_int& y) {
+    return x.p_ == y.p_;
+  }
+
+  /**
+   * Compares two distributions.
+   *
+   * @param x first distribution
+   * @param y second distribution
+   * @return `true` if they have different parameters, `false` otherwise
+   */
+  friend bool operator!=(const uniform_int& x, const uniform_int& y) {
+    return !(x == y);
+  }
+
+ private:
+  param_type p_;
+
+  static unsigned_type range(const param_type& p) {
+    return static_cast<unsigned_type>(static_cast<unsigned_type>(p.b()) -
+                                      static_cast<unsigned_type>(p.a()));
+  }
+
+  template <class URBG>
+  static unsigned_type offset(URBG& g, unsigned_type range) {
+    if (range < 0xffffffffU) {
+      return static_cast<unsigned_type>(detail::bounded32(
+          detail::draw_word32(g), static_cast<std::uint_least32_t>(range + 1),
+          g));
+    }
+    if (range == 0xffffffffU) {
+      return static_cast<unsigned_type>(detail::draw_word32(g));
+    }
+    if (range < std::numeric_limits<unsigned_type>::max()) {
+      return static_cast<unsigned_type>(detail::bounded64(
+          static_cast<std::uint_least64_t>(range) + 1, g));
+    }
+    return static_cast<unsigned_type>(detail::draw_word64(g));
+  }
+};
+
+/**
+ * Produces random numbers according to the normal distribution, by the
+ * 256-layer ziggurat method.
+ *
+ * In most cases, one value is made from a single output of the generator: the
+ * lowest 8 bits select the layer and the upper 24 bits (53 bits for 64-bit
+ * generators) give the value. The generator must generate full 32-bit or
+ * 64-bit words, like the engines in this library.
+ *
+ * @tparam RealType floating-point type of the results
+ */
+template <class RealType = double>
+class normal_distribution {
+  static_assert(std::is_floating_point<RealType>::value,
+                "result_type must be a floating-point type");
+
+ public:
+  /**
+   * Floating-point type of the results.
+   */
+  using result_type = RealType;
+
+  /**
+   * Type of the distribution parameters.
+   */
+  class param_type {
+    result_type mean_;
+    result_type stddev_;
+
+   public:
+    /**
+     * Type of the distribution.
+     */
+    using distribution_type = normal_distribution;
+
+    /**
+     * Constructs the parameters.
+     *
+     * @param mean   mean
+     * @param stddev standard deviation, must be positive
+     */
+    explicit param_type(result_type mean = 0, result_type stddev = 1)
+        : mean_(mean), stddev_(stddev) {}
+
+    /**
+     * Returns the mean.
+     *
+     * @return mean
+     */
+    result_type mean() const { return mean_; }
+
+    /**
+     * Returns the standard deviation.
+     *
+     * @return standard deviation
+     */
+    result_type stddev() const { return stddev_; }
+
+    /**
+     * Compares two parameter sets.
+     *
+     * @param x first parameter set
+     * @param y second parameter set
+     * @return `true` if they are equal, `false` otherwise
+     */
+    friend bool operator==(const param_type& x, const param_type& y) {
+      return !(x.mean_ < y.mean_) && !(y.mean_ < x.mean_) &&
+             !(x.stddev_ < y.stddev_) && !(y.stddev_ < x.stddev_);
+    }
+
+    /**
+     * Compares two parameter sets.
+     *
+     * @param x first parameter set
+     * @param y second parameter set
+     * @return `true` if they are not equal, `false` otherwise
+     */
+    friend bool operator!=(const param_type& x, const param_type& y) {
+      return !(x == y);
+    }
+  };
+
+  /**
+   * Constructs the distribution.
+   *
+   * @param mean   mean
+   * @param stddev standard deviation, must be positive
+   */
+  explicit normal_distribution(result_type mean = 0, result_type stddev = 1)
+      : p_(mean, stddev) {}
+
+  /**
+   * Constructs the distribution.
+   *
+   * @param p distribution parameters
+   */
+  explicit normal_distribution(const param_type& p) : p_(p) {}
+
+  /**
+   * Resets the internal state. This distribution has no internal state.
+   */
+  void reset() {}
+
+  /**
+   * Returns the mean.
+   *
+   * @return mean
+   */
+  result_type mean() const { return p_.mean(); }
+
+  /**
+   * Returns the standard deviation.
+   *
+   * @return standard deviation
+   */
+  result_type stddev() const { return p_.stddev(); }
+
+  /**
+   * Returns the distribution parameters.
+   *
+   * @return distribution parameters
+   */
+  param_type param() const { return p_; }
+
+  /**
+   * Sets the distribution parameters.
+   *
+   * @param p distribution parameters
+   */
+  void param(const param_type& p) { p_ = p; }
+
+  /**
+   * Returns the smallest possible value.
+   *
+   * @return smallest value
+   */
+  result_type min() const { return -std::numeric_limits<result_type>::max(); }
+
+  /**
+   * Returns the largest possible value.
+   *
+   * @return largest value
+   */
+  result_type max() const { return std::numeric_limits<result_type>::max(); }
 
-    // Assume that mat1, mat2, tmat have been suitably initialized.
+  /**
+   * Generates the next random number.
+   *
+   * @param g uniform random bit generator
+   * @return generated value
+   */
+  template <class URBG>
+  result_type operator()(URBG& g) {
+    return (*this)(g, p_);
+  }
 
-    s.status[0] = seed & mask32;
-    s.status[1] = s.mat1;
-    s.status[2] = s.mat2;
-    s.status[3] = s.tmat;
+  /**
+   * Generates the next random number with the given parameters.
+   *
+   * @param g uniform random bit generator
+   * @param p distribution parameters
+   * @return generated value
+   */
+  template <class URBG>
+  result_type operator()(URBG& g, const param_type& p) {
+    static_assert(detail::is_word_generator<URBG>::value,
+                  "URBG must generate full 32-bit or 64-bit words");
 
-    // See Knuth TAOCP Vol2. 3rd Ed. p.106 for the multiplier.
+    return transform(detail::ziggurat_normal(g(), g), p);
+  }
 
-    for (unsigned int i = 1; i < MIN_LOOP; i++) {
-      s.status[i & 3] ^= i + 1812433253 * (s.status[(i - 1) & 3] ^
-                                           (s.status[(i - 1) & 3] >> 30));
-      s.status[i & 3] &= mask32;
-    }
+  /**
+   * Fills the given range with random numbers. The results and the final state
+   * of the generator are the same as successive calls of `operator()`, but the
+   * outputs are taken from the generator in bulk when it supports
+   * `generate(first, last)`.
+   *
+   * @param first beginning of the range
+   * @param last  end of the range
+   * @param g     uniform random bit generator
+   */
+  template <class ForwardIt, class URBG>
+  void generate(ForwardIt first, ForwardIt last, URBG& g) {
+    static_assert(detail::is_word_generator<URBG>::value,
+                  "URBG must generate full 32-bit or 64-bit words");
 
-    if (DoPeriodCertification) {
-      period_certification(s);
-    }
+    using value_type = typename std::iterator_traits<ForwardIt>::value_type;
 
-    for (unsigned int i = 0; i < PRE_LOOP; i++) {
-      next_state(s);
+    detail::word_buffer<URBG> words(
+        g, static_cast<std::size_t>(std::distance(first, last)));
+    for (; first != last; ++first) {
+      const double z = detail::ziggurat_normal(words(), words);
+      *first = static_cast<value_type>(transform(z, p_));
+      words.finish_one();
     }
   }
 
-  template <TINYMT_CPP_ENABLE_WHEN(!is_twos_complement<result_type>::value)>
-  static void next_state(status_type& s) {
-    result_type x = (s.status[0] & mask) ^ s.status[1] ^ s.status[2];
-    result_type y = s.status[3];
-    x ^= (x << sh0) & mask32;
-    y ^= (y >> sh0) ^ x;
-    s.status[0] = s.status[1];
-    s.status[1] = s.status[2];
-    s.status[2] = (x ^ (y << sh1)) & mask32;
-    s.status[3] = y;
-    if (y & 1) {
-      s.status[1] ^= s.mat1;
-      s.status[2] ^= s.mat2;
-    }
+  /**
+   * Compares two distributions.
+   *
+   * @param x first distribution
+   * @param y second distribution
+   * @return `true` if they have the same parameters, `false` otherwise
+   */
+  friend bool operator==(const normal_distribution& x,
+                         const normal_distribution& y) {
+    return x.p_ == y.p_;
   }
 
-  template <TINYMT_CPP_ENABLE_WHEN(is_twos_complement<result_type>::value)>
-  static void next_state(status_type& s) {
-    result_type x = (s.status[0] & mask) ^ s.status[1] ^ s.status[2];
-    result_type y = s.status[3];
-    x ^= (x << sh0) & mask32;
-    y ^= (y >> sh0) ^ x;
-    s.status[0] = s.status[1];
-    s.status[1] = s.status[2];
-    s.status[2] = (x ^ (y << sh1)) & mask32;
-    s.status[3] = y;
-    // NOTE: the conditional branch in the portable version can be removed in
-    // the following way using negation in two's complement representation.
-    auto ymask =
-        static_cast<result_type>(-static_cast<signed_result_type>(y & 1));
-    s.status[1] ^= ymask & s.mat1;
-    s.status[2] ^= ymask & s.mat2;
+  /**
+   * Compares two distributions.
+   *
+   * @param x first distribution
+   * @param y second distribution
+   * @return `true` if they have different parameters, `false` otherwise
+   */
+  friend bool operator!=(const normal_distribution& x,
+                         const normal_distribution& y) {
+    return !(x == y);
   }
 
-  template <TINYMT_CPP_ENABLE_WHEN(!is_twos_complement<result_type>::value)>
-  static result_type temper(const status_type& s) {
-    result_type t0 = s.status[3];
-    result_type t1 = s.status[0] + (s.status[2] >> sh8);
-    t0 ^= t1;
-    if (t1 & 1) {
-      t0 ^= s.tmat;
-    }
-    return t0 & mask32;
-  }
+ private:
+  param_type p_;
 
-  template <TINYMT_CPP_ENABLE_WHEN(is_twos_complement<result_type>::value)>
-  static result_type temper(const status_type& s) {
-    result_type t0 = s.status[3];
-    result_type t1 = s.status[0] + (s.status[2] >> sh8);
-    t0 ^= t1;
-    // NOTE: the conditional branch in the portable version can be removed in
-    // the following way using negation in two's complement representation.
-    auto t1mask =
-        static_cast<result_type>(-static_cast<signed_result_type>(t1 & 1));
-    t0 ^= t1mask & s.tmat;
-    return t0 & mask32;
+  static result_type transform(double z, const param_type& p) {
+    return p.mean() + p.stddev() * static_cast<result_type>(z);
   }
 };
 
-}  // namespace detail
-
 /**
- * Pseudo-random number generator engine based on the TinyMT algorithms.
- *
- * @tparam UIntType unsigned integral type generated by the engine
- * @tparam WordSize word size for the generated numbers
- * @tparam Mat1     parameter used in the linear state transition function
- * @tparam Mat2     parameter used in the linear state transition function
- * @tparam TMat     parameter used in the non-linear output function
- * @tparam DoPeriodCertification whether or not period certification is
- * performed in initialization
+ * Produces random boolean values, `true` with probability `p`, spending as
+ * few random bits as possible.
  *
- * @note Currently `WordSize` must be `32`.
- * @note When `Mat`, `Mat2` and `TMat` are all zero, the generator parameter set
- * must be provided in initialization ("Dynamic Creation" (DC) mode).
+ * The outputs of the generator are buffered in the distribution and used bit
+ * by bit. A value is decided by comparing a uniform number made of these bits
+ * with the binary expansion of `p` from the most significant bit, which stops
+ * at the first difference: two bits are used on average, and exactly one for
+ * `p` = 0.5. `p` is taken to the precision of 2^-64. The generator must
+ * generate full 32-bit or 64-bit words, like the engines in this library, and
+ * the distribution should be used with a single generator, or `reset()` when
+ * switching generators.
  */
-template <class UIntType, std::size_t WordSize, UIntType Mat1, UIntType Mat2,
-          UIntType TMat, bool DoPeriodCertification = true>
-class tinymt_engine {
-  static_assert(std::is_integral<UIntType>::value &&
-                    std::is_unsigned<UIntType>::value,
-                "result_type must be an unsigned integral type");
-  static_assert(WordSize == 32, "word_size must be 32");
-
-  using impl = detail::tinymt_engine_impl<UIntType, WordSize, Mat1, Mat2, TMat,
-                                          DoPeriodCertification>;
-  using status_type =
-      detail::tinymt_engine_status<UIntType, WordSize, Mat1, Mat2, TMat>;
-
-  static_assert(std::numeric_limits<UIntType>::max() >= impl::max,
-                "size of result_type must be lager than word_size");
-  static_assert(Mat1 <= impl::max, "Mat1 must be < 2^word_size");
-  static_assert(Mat2 <= impl::max, "Mat2 must be < 2^word_size");
-  static_assert(TMat <= impl::max, "TMat must be < 2^word_size");
-
-  status_type s_;
-
+class bernoulli_distribution {
  public:
   /**
-   * Integral type generated by the engine.
+   * Type of the results.
    */
-  using result_type = UIntType;
+  using result_type = bool;
 
   /**
-   * Type of the generator parameter set.
+   * Type of the distribution parameters.
    */
-  using param_type = typename impl::param_type;
+  class param_type {
+    double p_;
+    std::uint_least64_t bits_;
 
-  /**
-   * Word size that determines the range of numbers generated by the engine.
-   */
-  static constexpr std::size_t word_size = WordSize;
+   public:
+    /**
+     * Type of the distribution.
+     */
+    using distribution_type = bernoulli_distribution;
+
+    /**
+     * Constructs the parameters.
+     *
+     * @param p probability of `true`, must be in [0, 1]
+     */
+    explicit param_type(double p = 0.5)
+        : p_(p), bits_(detail::probability_bits(p)) {}
+
+    /**
+     * Returns the probability of `true`.
+     *
+     * @return probability
+     */
+    double p() const { return p_; }
+
+    /**
+     * Compares two parameter sets.
+     *
+     * @param x first parameter set
+     * @param y second parameter set
+     * @return `true` if they are equal, `false` otherwise
+     */
+    friend bool operator==(const param_type& x, const param_type& y) {
+      return !(x.p_ < y.p_) && !(y.p_ < x.p_);
+    }
+
+    /**
+     * Compares two parameter sets.
+     *
+     * @param x first parameter set
+     * @param y second parameter set
+     * @return `true` if they are not equal, `false` otherwise
+     */
+    friend bool operator!=(const param_type& x, const param_type& y) {
+      return !(x == y);
+    }
+
+   private:
+    friend class bernoulli_distribution;
+  };
 
   /**
-   * Size of the state of the generator in words.
+   * Constructs the distribution.
+   *
+   * @param p probability of `true`, must be in [0, 1]
    */
-  static constexpr std::size_t state_size = impl::state_size;
+  explicit bernoulli_distribution(double p = 0.5) : p_(p), bits_(0), size_(0) {}
 
   /**
-   * Default seed.
+   * Constructs the distribution.
+   *
+   * @param p distribution parameters
    */
-  static constexpr result_type default_seed = 1;
+  explicit bernoulli_distribution(const param_type& p)
+      : p_(p), bits_(0), size_(0) {}
 
   /**
-   * Constructs the engine (non-DC mode).
-   *
-   * @param seed random seed
+   * Resets the internal state, discarding the buffered bits.
    */
-  template <TINYMT_CPP_ENABLE_WHEN(!status_type::is_dynamic::value)>
-  explicit tinymt_engine(result_type seed = default_seed) {
-    impl::init(s_, seed);
+  void reset() {
+    bits_ = 0;
+    size_ = 0;
   }
 
   /**
-   * Constructs the engine (DC mode).
+   * Returns the probability of `true`.
    *
-   * @param param parameter set
-   * @param seed random seed
+   * @return probability
    */
-  template <TINYMT_CPP_ENABLE_WHEN(status_type::is_dynamic::value)>
-  explicit tinymt_engine(const param_type& param,
-                         result_type seed = default_seed) {
-    s_.mat1 = param.mat1 & impl::word_mask;
-    s_.mat2 = param.mat2 & impl::word_mask;
-    s_.tmat = param.tmat & impl::word_mask;
-    impl::init(s_, seed);
-  }
+  double p() const { return p_.p(); }
 
   /**
-   * Reinitializes the engine.
+   * Returns the distribution parameters.
    *
-   * @param value random seed
+   * @return distribution parameters
    */
-  void seed(result_type value = default_seed) { impl::init(s_, value); }
+  param_type param() const { return p_; }
 
   /**
-   * Advances the state of the engine by the given amount.
+   * Sets the distribution parameters.
    *
-   * @param z number of advances
+   * @param p distribution parameters
    */
-  // Note: the use of `unsigned long long` is intentional, following the
-  // standard library and the Boost library.
-  void discard(unsigned long long z) {            // NOLINT
-    for (unsigned long long i = 0; i < z; i++) {  // NOLINT
-      impl::next_state(s_);
-    }
-  }
+  void param(const param_type& p) { p_ = p; }
 
   /**
-   * Returns the smallest possible value in the output range.
+   * Returns the smallest possible value.
    *
    * @return smallest value
    */
-  static constexpr result_type min() { return 0; }
+  static constexpr result_type min() { return false; }
 
   /**
-   * Returns the largest possible value in the output range.
+   * Returns the largest possible value.
    *
    * @return largest value
    */
-  static constexpr result_type max() { return impl::max; }
+  static constexpr result_type max() { return true; }
 
   /**
-   * Returns the next pseudo-random number.
+   * Generates the next random value.
    *
+   * @param g uniform random bit generator
    * @return generated value
    */
-  result_type operator()() {
-    impl::next_state(s_);
-    return impl::temper(s_);
+  template <class URBG>
+  result_type operator()(URBG& g) {
+    return (*this)(g, p_);
   }
 
   /**
-   * Compares two engines.
+   * Generates the next random value with the given parameters.
    *
-   * @param a first engine
-   * @param b second engine
-   * @return `true` if the engines are equivalent including their internal
-   * states, `false` otherwise
+   * @param g uniform random bit generator
+   * @param p distribution parameters
+   * @return generated value
    */
-  friend bool operator==(const tinymt_engine& a, const tinymt_engine& b) {
-    return a.s_ == b.s_;
+  template <class URBG>
+  result_type operator()(URBG& g, const param_type& p) {
+    static_assert(detail::is_word_generator<URBG>::value,
+                  "URBG must generate full 32-bit or 64-bit words");
+
+    if (p.bits_ == 0) {
+      return p.p_ >= 1;
+    }
+    const std::uint_least64_t mask64 = 0xffffffffffffffffU;
+    // Remaining bits of p, aligned to the most significant bit.
+    std::uint_least64_t rest = p.bits_;
+    for (;;) {
+      if (size_ == 0) {
+        refill(g);
+      }
+      // The comparison ends at the last set bit of p: U >= p if they agree.
+      const std::size_t len = 64 - detail::highest_bit(rest & (0U - rest));
+      const std::size_t n = size_ < len ? size_ : len;
+      const std::uint_least64_t x = (bits_ ^ rest) & top_bits(n);
+      // Position of the first difference, or the last compared bit. Computed
+      // without branches because the random bits are unpredictable.
+      const std::uint_least64_t last = std::uint_least64_t(1) << (64 - n);
+      const std::size_t k = 63 - detail::highest_bit(x | last);
+      consume(k + 1);
+      // Either x != 0 or n == len, tested at once, is almost always true.
+      if ((x | static_cast<std::uint_least64_t>(n == len)) != 0) {
+        // The first difference decides: U < p if p has 1 there.
+        return (((x & rest) >> (63 - k)) & 1U) != 0;
+      }
+      rest = (rest << n) & mask64;
+    }
   }
 
   /**
-   * Compares two engines.
+   * Compares two distributions.
    *
-   * @param a first engine
-   * @param b second engine
-   * @return `true` if the engines are not equivalent including their internal
-   * states, `false` otherwise
+   * @param x first distribution
+   * @param y second distribution
+   * @return `true` if they have the same parameters and buffered bits, `false`
+   * otherwise
    */
-  friend bool operator!=(const tinymt_engine& a, const tinymt_engine& b) {
-    return a.s_ != b.s_;
+  friend bool operator==(const bernoulli_distribution& x,
+                         const bernoulli_distribution& y) {
+    return x.p_ == y.p_ && x.bits_ == y.bits_ && x.size_ == y.size_;
   }
 
   /**
-   * Serializes the state of the given engine into a stream.
+   * Compares two distributions.
    *
-   * @param os output stream
-   * @param e  engine to be serialized
-   * @return `os`
+   * @param x first distribution
+   * @param y second distribution
+   * @return `true` if they have different parameters or buffered bits,
+   * `false` otherwise
    */
-  template <class CharT, class Traits>
-  friend std::basic_ostream<CharT, Traits>& operator<<(
-      std::basic_ostream<CharT, Traits>& os, const tinymt_engine& e) {
-    return os << e.s_;
+  friend bool operator!=(const bernoulli_distribution& x,
+                         const bernoulli_distribution& y) {
+    return !(x == y);
   }
 
-  /**
-   * Deserializes the state of the given engine from a stream.
-   *
-   * @param is input stream
-   * @param e  engine to be deserialized
-   * @return `is`
-   */
-  template <class CharT, class Traits>
-  friend std::basic_istream<CharT, Traits>& operator>>(
-      std::basic_istream<CharT, Traits>& is, tinymt_engine& e) {
-    return is >> e.s_;
+ private:
+  param_type p_;
+  // Unused bits, aligned to the most significant bit.
+  std::uint_least64_t bits_;
+  // Number of unused bits.
+  std::size_t size_;
+
+  static std::uint_least64_t top_bits(std::size_t n) {
+    const std::uint_least64_t mask64 = 0xffffffffffffffffU;
+    return n < 64 ? ~(mask64 >> n) & mask64 : mask64;
+  }
+
+  void consume(std::size_t n) {
+    const std::uint_least64_t mask64 = 0xffffffffffffffffU;
+    bits_ = n < 64 ? (bits_ << n) & mask64 : 0;
+    size_ -= n;
+  }
+
+  template <class URBG>
+  void refill(URBG& g) {
+    if (URBG::max() == 0xffffffffU) {
+      bits_ = static_cast<std::uint_least64_t>(g()) << 32;
+      size_ = 32;
+    } else {
+      bits_ = static_cast<std::uint_least64_t>(g());
+      size_ = 64;
+    }
   }
 };
 
 /**
- * TinyMT32 generator engine with the parameter set specified in RFC 8682.
+ * Fills the given array with normally distributed random numbers.
+ *
+ * @param p      pointer to the first element of the array
+ * @param n      number of elements
+ * @param g      uniform random bit generator
+ * @param mean   mean
+ * @param stddev standard deviation, must be positive
  */
-using tinymt32 =
-    tinymt_engine<uint_fast32_t, 32, detail::tinymt32_default_param_mat1,
-                  detail::tinymt32_default_param_mat2,
-                  detail::tinymt32_default_param_tmat, false>;
+template <class RealType, class URBG>
+inline void fill_normal(RealType* p, std::size_t n, URBG& g, RealType mean = 0,
+                        RealType stddev = 1) {
+  normal_distribution<RealType>(mean, stddev).generate(p, p + n, g);
+}
 
 /**
- * TinyMT32 generator engine with "Dynamic Creation" of its parameter set.
+ * Fills the given array with random numbers uniformly distributed on [a, b).
+ *
+ * Element `i` is `a + (b - a) * u`, where `u` is made from the `i`-th output
+ * `x` of the generator: for a 32-bit generator, `u` is the same as
+ * `generate_float01()` (the upper 23 bits of `x`) for `float` and
+ * `generate_32double()` (`x` * 2^-32) for `double`; for a 64-bit generator,
+ * `u` is the upper 23 bits of `x` for `float` and the same as
+ * `generate_double01()` (the upper 52 bits of `x`) for `double`. The numbers
+ * are generated and converted in a single pass, for TinyMT32 in several
+ * substreams together by SIMD instructions (see
+ * `tinymt_engine::generate_transform()`). Note that `b` may be returned by
+ * rounding.
+ *
+ * @param p pointer to the first element of the array
+ * @param n number of elements
+ * @param g uniform random bit generator of 32-bit or 64-bit words
+ * @param a lower bound
+ * @param b upper bound
  */
-using tinymt32_dc = tinymt_engine<uint_fast32_t, 32, 0, 0, 0, true>;
+template <class RealType, class URBG>
+inline void fill_uniform(RealType* p, std::size_t n, URBG& g, RealType a = 0,
+                         RealType b = 1) {
+  static_assert(std::is_same<RealType, float>::value ||
+                    std::is_same<RealType, double>::value,
+                "RealType must be float or double");
+  static_assert(detail::is_word_generator<URBG>::value,
+                "URBG must generate 32-bit or 64-bit words");
+  detail::fill_uniform(
+      p, n, g, a, b - a,
+      std::integral_constant<
+          bool, detail::has_generate_transform<URBG, RealType>::value>());
+}
+
+/**
+ * Fills the given bit array with random bits, each of which is 1 with
+ * probability `p`, e.g., for dropout and subsampling masks.
+ *
+ * Bit `i` is stored in bit `i % 64` of `bits[i / 64]`, and the unused bits of
+ * the last word are cleared. The 64 bits of a word are decided together, by
+ * comparing 64 uniform numbers made bit by bit from 64-bit words of the
+ * generator with the binary expansion of `p`, until all the bits are decided
+ * or `p` has no more set bits. This takes a single 64-bit word for `p` = 0.5
+ * and about eight for general `p`, taken to the precision of 2^-64. No words
+ * are taken for `p` = 0 or 1.
+ *
+ * @param bits pointer to the first word of the bit array, of at least
+ * `(n + 63) / 64` words
+ * @param n    number of bits
+ * @param g    uniform random bit generator of 32-bit or 64-bit words
+ * @param p    probability of 1, must be in [0, 1]
+ */
+template <class URBG>
+inline void fill_mask(std::uint_least64_t* bits, std::size_t n, URBG& g,
+                      double p = 0.5) {
+  static_assert(detail::is_word_generator<URBG>::value,
+                "URBG must generate full 32-bit or 64-bit words");
+
+  const std::uint_least64_t mask64 = 0xffffffffffffffffU;
+  const std::size_t words = (n + 63) / 64;
+  const std::uint_least64_t pbits = detail::probability_bits(p);
+  if (pbits == 0) {
+    std::fill(bits, bits + words, p >= 1 ? mask64 : 0);
+  } else {
+    detail::word_buffer<URBG> buf(g, words);
+    for (std::size_t i = 0; i < words; i++) {
+      std::uint_least64_t rest = pbits;
+      std::uint_least64_t undecided = mask64;
+      std::uint_least64_t result = 0;
+      while (rest != 0 && undecided != 0) {
+        const std::uint_least64_t r = detail::draw_word64(buf);
+        if ((rest >> 63) != 0) {
+          // Decided as 1 where the random bit is 0.
+          result |= undecided & ~r;
+          undecided &= r;
+        } else {
+          // Decided as 0 where the random bit is 1.
+          undecided &= ~r;
+        }
+        rest = (rest << 1) & mask64;
+      }
+      bits[i] = result & mask64;
+      buf.finish_one();
+    }
+  }
+  if (n % 64 != 0) {
+    bits[words - 1] &= (std::uint_least64_t(1) << (n % 64)) - 1;
+  }
+}
+
+/**
+ * Randomly permutes the elements in the given range by the Fisher-Yates
+ * shuffle, as `std::shuffle` but with cheaper random indices.
+ *
+ * The index for each position is made by Lemire's nearly divisionless method
+ * from a single 32-bit word (or a 64-bit word for more than 2^32 elements).
+ * Below 2^16 elements, two indices are made from a single 32-bit word. For
+ * large ranges, the indices are drawn a few positions ahead and the elements
+ * are prefetched. The result depends only on the initial state of the
+ * generator.
+ *
+ * @param first beginning of the range
+ * @param last  end of the range
+ * @param g     uniform random bit generator of 32-bit or 64-bit words
+ */
+template <class RandomIt, class URBG>
+inline void shuffle(RandomIt first, RandomIt last, URBG& g) {
+  static_assert(detail::is_word_generator<URBG>::value,
+                "URBG must generate full 32-bit or 64-bit words");
+
+  using std::swap;
+
+  const auto n = static_cast<std::uint_least64_t>(last - first);
+  if (n < 2) {
+    return;
+  }
+
+  // Positions i >= PAIR_LIMIT take a word each; the rest are paired, with
+  // (i + 1) * i < 2^32.
+  const std::uint_least64_t PAIR_LIMIT = 0x10000U;
+  const std::uint_least64_t LOOKAHEAD = 8;
+  const std::uint_least64_t single = n > PAIR_LIMIT ? n - PAIR_LIMIT : 0;
+  const std::uint_least64_t paired = (n - 1 - single + 1) / 2;
+  detail::word_buffer<URBG> words(g, static_cast<std::size_t>(single + paired));
+
+  std::uint_least64_t i = n - 1;
+  std::uint_least64_t js[LOOKAHEAD];
+  while (i >= PAIR_LIMIT) {
+    const std::uint_least64_t m =
+        i - PAIR_LIMIT + 1 < LOOKAHEAD ? i - PAIR_LIMIT + 1 : LOOKAHEAD;
+    for (std::uint_least64_t k = 0; k < m; k++) {
+      js[k] = detail::bounded_index(i - k + 1, words);
+      words.finish_one();
+      detail::prefetch(first + static_cast<std::ptrdiff_t>(js[k]));
+    }
+    for (std::uint_least64_t k = 0; k < m; k++, i--) {
+      swap(first[static_cast<std::ptrdiff_t>(i)],
+           first[static_cast<std::ptrdiff_t>(js[k])]);
+    }
+  }
+  for (; i >= 2; i -= 2) {
+    std::uint_least32_t j1;
+    std::uint_least32_t j2;
+    detail::bounded32_pair(static_cast<std::uint_least32_t>(i + 1),
+                           static_cast<std::uint_least32_t>(i), j1, j2, words);
+    words.finish_one();
+    swap(first[static_cast<std::ptrdiff_t>(i)], first[j1]);
+    swap(first[static_cast<std::ptrdiff_t>(i - 1)], first[j2]);
+  }
+  if (i == 1) {
+    const std::uint_least64_t j = detail::bounded_index(2, words);
+    words.finish_one();
+    swap(first[1], first[static_cast<std::ptrdiff_t>(j)]);
+  }
+}
+
+/**
+ * Assigns a random permutation of 0, 1, ..., `n` - 1 to the given range of
+ * `n` elements. Equivalent to assigning the sequence and calling `shuffle()`.
+ *
+ * @param first beginning of the range
+ * @param last  end of the range
+ * @param g     uniform random bit generator of 32-bit or 64-bit words
+ */
+template <class RandomIt, class URBG>
+inline void random_permutation(RandomIt first, RandomIt last, URBG& g) {
+  using value_type = typename std::iterator_traits<RandomIt>::value_type;
+
+  value_type v = value_type();
+  for (RandomIt it = first; it != last; ++it, ++v) {
+    *it = v;
+  }
+  tinymt::shuffle(first, last, g);
+}
+
+/**
+ * Selects `k` distinct integers uniformly from [0, `n`) by Floyd's algorithm,
+ * which takes `k` random numbers and O(k) memory regardless of `n`. Every
+ * subset of size `k` is equally likely, but the order of the results is not
+ * random; use `shuffle()` if needed.
+ *
+ * @param n   size of the population
+ * @param k   number of the samples; all `n` integers if `k > n`
+ * @param out beginning of the destination range
+ * @param g   uniform random bit generator of 32-bit or 64-bit words
+ * @return end of the destination range
+ */
+template <class OutputIt, class URBG>
+inline OutputIt sample_without_replacement(std::uint_least64_t n,
+                                           std::uint_least64_t k, OutputIt out,
+                                           URBG& g) {
+  static_assert(detail::is_word_generator<URBG>::value,
+                "URBG must generate full 32-bit or 64-bit words");
+
+  if (k > n) {
+    k = n;
+  }
+  std::unordered_set<std::uint_least64_t> chosen;
+  chosen.reserve(static_cast<std::size_t>(k));
+  for (std::uint_least64_t j = n - k; j < n; j++) {
+    const std::uint_least64_t t = detail::bounded_index(j + 1, g);
+    const std::uint_least64_t v = chosen.insert(t).second ? t : j;
+    if (v == j) {
+      chosen.insert(j);
+    }
+    *out = v;
+    ++out;
+  }
+  return out;
+}
+
+/**
+ * Selects `k` elements uniformly from the given range in a single pass by
+ * reservoir sampling (Algorithm R). The length of the range need not be known
+ * in advance. Every subset of size `k` is equally likely, but the order of the
+ * results is not random; use `shuffle()` if needed.
+ *
+ * @param first beginning of the population
+ * @param last  end of the population
+ * @param out   beginning of the destination range, of at least `k` elements
+ * @param k     number of the samples; all the elements if the population has
+ * fewer elements
+ * @param g     uniform random bit generator of 32-bit or 64-bit words
+ * @return end of the samples in the destination range
+ */
+template <class InputIt, class RandomIt, class URBG>
+inline RandomIt sample_without_replacement(InputIt first, InputIt last,
+                                           RandomIt out, std::size_t k,
+                                           URBG& g) {
+  static_assert(detail::is_word_generator<URBG>::value,
+                "URBG must generate full 32-bit or 64-bit words");
+
+  std::uint_least64_t i = 0;
+  for (; first != last && i < k; ++first, ++i) {
+    out[static_cast<std::ptrdiff_t>(i)] = *first;
+  }
+  for (; first != last; ++first, ++i) {
+    const std::uint_least64_t j = detail::bounded_index(i + 1, g);
+    if (j < k) {
+      out[static_cast<std::ptrdiff_t>(j)] = *first;
+    }
+  }
+  return out + static_cast<std::ptrdiff_t>(i < k ? i : k);
+}
 
 }  // namespace tinymt
 
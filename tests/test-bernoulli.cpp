@@ -0,0 +1,165 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest/doctest.h>
+#include <tinymt/tinymt.h>
+
+#include <cmath>
+#include <vector>
+
+using namespace std;
+using namespace tinymt;
+
+namespace {
+
+int popcount64(uint64_t x) {
+  int n = 0;
+  for (; x != 0; x &= x - 1) {
+    n++;
+  }
+  return n;
+}
+
+// Reference: compares the binary expansion of p with a uniform number made of
+// the bits taken one by one, from the most significant bit of each output.
+template <typename Rng>
+struct bit_reference {
+  Rng r;
+  uint64_t word = 0;
+  int left = 0;
+
+  explicit bit_reference(const Rng& rng) : r(rng) {}
+
+  int next_bit() {
+    const int width = Rng::word_size;
+    if (left == 0) {
+      word = r();
+      left = width;
+    }
+    left--;
+    return static_cast<int>((word >> left) & 1);
+  }
+
+  bool operator()(double p) {
+    for (;;) {
+      p *= 2;
+      const int b = p >= 1 ? 1 : 0;
+      p -= b;
+      const int u = next_bit();
+      if (u != b) {
+        return b == 1;
+      }
+      if (p == 0) {
+        return false;
+      }
+    }
+  }
+};
+
+}  // namespace
+
+TEST_CASE("bernoulli_distribution") {
+  // Dyadic probabilities are exact in double arithmetic of the reference.
+  for (double p : {0.5, 0.25, 0.75, 0.1, 0.3, 1.0 / 3.0, 0.999}) {
+    tinymt32 r1(42);
+    bit_reference<tinymt32> r2(tinymt32(42));
+    bernoulli_distribution dist(p);
+    bool ok = true;
+    for (int i = 0; i < 10000; i++) {
+      ok = ok && dist(r1) == r2(p);
+    }
+    CHECK_MESSAGE(ok, "p = " << p);
+  }
+
+  tinymt64 r1(42);
+  bit_reference<tinymt64> r2(tinymt64(42));
+  bernoulli_distribution dist(0.3);
+  bool ok = true;
+  for (int i = 0; i < 10000; i++) {
+    ok = ok && dist(r1) == r2(0.3);
+  }
+  CHECK(ok);
+}
+
+TEST_CASE("bernoulli_distribution (bits)") {
+  // p = 0.5 uses one bit per value.
+  tinymt32 r1(1);
+  tinymt32 r2(1);
+  bernoulli_distribution dist;
+  for (int i = 0; i < 10; i++) {
+    const uint32_t x = static_cast<uint32_t>(r2());
+    for (int k = 31; k >= 0; k--) {
+      CHECK(dist(r1) == (((x >> k) & 1) == 0));
+    }
+  }
+  CHECK(r1 == r2);
+
+  // About two bits per value in general.
+  tinymt32 r3(1);
+  tinymt32 r4(1);
+  dist.param(bernoulli_distribution::param_type(0.3));
+  const int n = 32000;
+  for (int i = 0; i < n; i++) {
+    dist(r3);
+  }
+  int words = 0;
+  while (r4 != r3) {
+    r4();
+    words++;
+  }
+  CHECK(words < n * 3 / 32);
+
+  tinymt32 r5(1);
+  CHECK(bernoulli_distribution(0.0)(r5) == false);
+  CHECK(bernoulli_distribution(1.0)(r5) == true);
+  CHECK(r5 == tinymt32(1));
+
+  bernoulli_distribution d1(0.3);
+  bernoulli_distribution d2(0.3);
+  CHECK(d1 == d2);
+  d1(r5);
+  CHECK(d1 != d2);
+  d1.reset();
+  CHECK(d1 == d2);
+}
+
+TEST_CASE("fill_mask") {
+  for (double p : {0.0, 0.5, 0.1, 0.9, 1.0}) {
+    const size_t n = 100000 + 37;
+    vector<uint64_t> bits((n + 63) / 64, ~uint64_t(0));
+    tinymt32 r(42);
+    fill_mask(bits.data(), n, r, p);
+    CHECK((bits.back() >> (n % 64)) == 0);
+    int count = 0;
+    for (uint64_t w : bits) {
+      count += popcount64(w);
+    }
+    // The standard deviation is at most 159.
+    CHECK_MESSAGE(fabs(count - p * n) < 800, "p = " << p);
+  }
+
+  // Compared with the reference, for each lane of the words.
+  const double p = 0.3;
+  uint64_t bits[4];
+  tinymt64 r1(7);
+  fill_mask(bits, 4 * 64, r1, p);
+  tinymt64 r2(7);
+  for (int i = 0; i < 4; i++) {
+    uint64_t undecided = ~uint64_t(0);
+    uint64_t expected = 0;
+    double q = p;
+    while (undecided != 0 && q != 0) {
+      const uint64_t w = r2();
+      q *= 2;
+      const uint64_t b = q >= 1 ? 1 : 0;
+      q -= static_cast<double>(b);
+      for (int l = 0; l < 64; l++) {
+        const uint64_t u = (w >> l) & 1;
+        if (((undecided >> l) & 1) != 0 && u != b) {
+          undecided &= ~(uint64_t(1) << l);
+          expected |= b << l;
+        }
+      }
+    }
+    CHECK(bits[i] == expected);
+  }
+  CHECK(r1 == r2);
+}
@@ -0,0 +1,100 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest/doctest.h>
+#include <tinymt/tinymt.h>
+
+#include <random>
+
+using namespace std;
+using namespace tinymt;
+
+TEST_CASE("range") {
+  CHECK(buffered_engine<tinymt32>::min() == tinymt32::min());
+  CHECK(buffered_engine<tinymt32>::max() == tinymt32::max());
+  CHECK(buffered_engine<tinymt64>::max() == tinymt64::max());
+}
+
+TEST_CASE("sequence") {
+  tinymt32 r1(42);
+  buffered_engine<tinymt32, 16> r2(42);
+
+  for (int i = 0; i < 1000; i++) {
+    CHECK_MESSAGE(r1() == r2(), "i = " << i);
+  }
+
+  const tinymt32_dc::param_type param = {0x8f7011eeU, 0xfc78ff1fU,
+                                         0x3793fdffU};
+  tinymt32_dc r3(param, 42);
+  buffered_engine<tinymt32_dc> r4(r3);
+
+  for (int i = 0; i < 1000; i++) {
+    CHECK_MESSAGE(r3() == r4(), "i = " << i);
+  }
+}
+
+TEST_CASE("seed") {
+  buffered_engine<tinymt64, 16> r1;
+  r1();
+  r1.seed(42);
+
+  tinymt64 r2(42);
+  for (int i = 0; i < 100; i++) {
+    CHECK_MESSAGE(r1() == r2(), "i = " << i);
+  }
+}
+
+TEST_CASE("discard") {
+  const unsigned long long zs[] = {0, 1, 5, 11, 16, 17, 100, 12345};  // NOLINT
+
+  for (auto z : zs) {
+    tinymt32 r1;
+    buffered_engine<tinymt32, 16> r2;
+
+    // Partially consumed buffer.
+    for (int i = 0; i < 5; i++) {
+      r1();
+      r2();
+    }
+
+    r1.discard(z);
+    r2.discard(z);
+
+    for (int i = 0; i < 40; i++) {
+      CHECK_MESSAGE(r1() == r2(), "z = " << z << ", i = " << i);
+    }
+  }
+}
+
+TEST_CASE("equals") {
+  buffered_engine<tinymt32, 16> r1;
+  buffered_engine<tinymt32, 16> r2;
+
+  CHECK(r1 == r2);
+
+  r1();
+  CHECK(r1 != r2);
+
+  // Same position with different buffered outputs.
+  r2.discard(1);
+  CHECK(r1 == r2);
+
+  for (int i = 0; i < 15; i++) {
+    r1();
+  }
+  r2.discard(15);
+  CHECK(r1 == r2);
+  r1();
+  CHECK(r1 != r2);
+  r2.discard(1);
+  CHECK(r1 == r2);
+  CHECK(r2 == r1);
+}
+
+TEST_CASE("distribution") {
+  tinymt32 r1(1);
+  buffered_engine<tinymt32> r2(1);
+
+  uniform_int_distribution<int> dist(1, 6);
+  for (int i = 0; i < 1000; i++) {
+    CHECK_MESSAGE(dist(r1) == dist(r2), "i = " << i);
+  }
+}
@@ -0,0 +1,89 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest/doctest.h>
+#include <tinymt/tinymt.h>
+
+#include <cstdint>
+#include <random>
+
+using namespace std;
+using namespace tinymt;
+
+#if TINYMT_CPP_USE_CLMUL
+
+namespace {
+
+bool operator==(const detail::f2_polynomial& a,
+                const detail::f2_polynomial& b) {
+  return a.coef[0] == b.coef[0] && a.coef[1] == b.coef[1];
+}
+
+// Random polynomial of degree less than tinymt_mexp.
+detail::f2_polynomial random_polynomial(mt19937_64& r) {
+  detail::f2_polynomial p;
+  p.coef[0] = r();
+  p.coef[1] = r() >> 1;
+  return p;
+}
+
+}  // namespace
+
+TEST_CASE("squaring") {
+  if (!__builtin_cpu_supports("pclmul")) {
+    MESSAGE("PCLMULQDQ is not supported by the CPU");
+    return;
+  }
+
+  using impl = detail::tinymt_engine_impl<uint_fast32_t, 32, 0, 0, 0, true>;
+  impl::status_type s;
+  s.mat1 = 0x8f7011eeU;
+  s.mat2 = 0xfc78ff1fU;
+  s.tmat = 0x3793fdffU;
+  const detail::f2_modulus m =
+      detail::f2_make_modulus(impl::characteristic_polynomial(s));
+
+  mt19937_64 r(1);
+  for (int i = 0; i < 1000; i++) {
+    const detail::f2_polynomial a = random_polynomial(r);
+    const detail::f2_polynomial b = random_polynomial(r);
+    CHECK(detail::f2_mul_clmul(a, b) == detail::f2_mul_portable(a, b));
+    const auto t = detail::f2_mul_portable(a, b);
+    CHECK(detail::f2_reduce_clmul(t, m) == detail::f2_reduce_portable(t, m));
+    detail::f2_polynomial p1 = a;
+    detail::f2_polynomial p2 = a;
+    detail::f2_sqr_mod_clmul(p1, m);
+    detail::f2_sqr_mod_portable(p2, m);
+    CHECK(p1 == p2);
+  }
+}
+
+TEST_CASE("discard") {
+  if (!__builtin_cpu_supports("pclmul")) {
+    MESSAGE("PCLMULQDQ is not supported by the CPU");
+    return;
+  }
+
+  // Jumps by the squarings, against steps one by one.
+  tinymt32 r1(42);
+  tinymt32 r2(42);
+  r1.discard(100000);
+  for (int i = 0; i < 100000; i++) {
+    r2();
+  }
+  CHECK(r1 == r2);
+  r1.rewind(100000);
+  CHECK(r1 == tinymt32(42));
+
+  tinymt64 r3(42);
+  tinymt64 r4(42);
+  r3.discard(100000);
+  for (int i = 0; i < 100000; i++) {
+    r4();
+  }
+  CHECK(r3 == r4);
+}
+
+#else
+
+TEST_CASE("squaring") { MESSAGE("TINYMT_CPP_USE_CLMUL is disabled"); }
+
+#endif
@@ -0,0 +1,76 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest/doctest.h>
+#include <tinymt/tinymt.h>
+
+#include <array>
+
+using namespace std;
+using namespace tinymt;
+
+namespace {
+
+// Built at compile time if possible.
+
+TINYMT_CPP_CONSTEXPR array<uint_fast32_t, 5> make_table() {
+  array<uint_fast32_t, 5> a{};
+  tinymt32 r;
+  for (auto& x : a) {
+    x = r();
+  }
+  return a;
+}
+
+TINYMT_CPP_CONSTEXPR uint_fast32_t nth(uint_fast32_t seed, unsigned int n) {
+  tinymt32 r(seed);
+  r.discard(n - 1);
+  return r();
+}
+
+TINYMT_CPP_CONSTEXPR uint_fast32_t fifth_by_step_back() {
+  tinymt32 r;
+  r.discard(6);
+  r.step_back();
+  r.step_back();
+  return r();
+}
+
+TINYMT_CPP_CONSTEXPR uint_fast32_t dc_first() {
+  tinymt32_dc r({0xda251b45U, 0xfed0ffb5U, 0x9b5cf7ffU});
+  r.seed(42);
+  r.discard(9);
+  return r();
+}
+
+TINYMT_CPP_CONSTEXPR uint_fast64_t tinymt64_first() {
+  tinymt64 r;
+  array<uint_fast64_t, 3> a{};
+  r.generate(a.begin(), a.end());
+  return a[0];
+}
+
+}  // namespace
+
+#if TINYMT_CPP_HAS_CONSTEXPR_ENGINE
+
+constexpr array<uint_fast32_t, 5> table = make_table();
+
+static_assert(table[0] == 2545341989U, "RFC 8682");
+static_assert(table[4] == 3591001365U, "RFC 8682");
+static_assert(nth(1, 10) == 764534509U, "RFC 8682");
+static_assert(fifth_by_step_back() == 3591001365U, "RFC 8682");
+static_assert(dc_first() == 2165469340U, "tinymtdc-longbatch");
+static_assert(tinymt64_first() == 15503804787016557143U, "reference");
+
+#endif
+
+TEST_CASE("constexpr") {
+  // The same at run time.
+  array<uint_fast32_t, 5> a = make_table();
+  CHECK(a[0] == 2545341989U);
+  CHECK(a[1] == 981918433U);
+  CHECK(a[4] == 3591001365U);
+  CHECK(nth(1, 10) == 764534509U);
+  CHECK(fifth_by_step_back() == 3591001365U);
+  CHECK(dc_first() == 2165469340U);
+  CHECK(tinymt64_first() == 15503804787016557143U);
+}
@@ -0,0 +1,174 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest/doctest.h>
+#include <tinymt/counter_registry.h>
+
+#include <cstdint>
+#include <limits>
+#include <list>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std;
+using namespace tinymt;
+
+namespace {
+
+const uint_least64_t max_count = numeric_limits<uint_least64_t>::max();
+
+}  // namespace
+
+// No space for the default policy.
+static_assert(sizeof(tinymt32_counted<no_counter>) == sizeof(tinymt32),
+              "no_counter must take no space");
+
+TEST_CASE("engine_counter") {
+  tinymt32_counted<> r1(42);
+  tinymt32 r2(42);
+  const engine_counts& c = r1.counter().counts();
+  CHECK(c.draws == 0);
+  CHECK(c.discarded == 0);
+  CHECK(c.seeds == 1);
+  CHECK(c.filled == 0);
+
+  for (int i = 0; i < 10; i++) {
+    CHECK(r1() == r2());
+  }
+  CHECK(r1.generate_float01() == r2.generate_float01());
+  CHECK(c.draws == 11);
+
+  r1.discard(1000);
+  r2.discard(1000);
+  CHECK(c.discarded == 1000);
+
+  vector<uint_fast32_t> x(100);
+  r1.fill(x.data(), x.size());
+  list<uint_fast32_t> y(50);
+  r1.generate(y.begin(), y.end());
+  vector<float> z(30);
+  fill_uniform(z.data(), z.size(), r1);
+  CHECK(c.filled == 180);
+  CHECK(c.draws == 11);
+
+  r1.seed(7);
+  r2.seed(7);
+  CHECK(c.seeds == 2);
+  CHECK(r1() == r2());
+
+  // Distributions draw numbers one by one.
+  uniform_int<int> dist(0, 9);
+  dist(r1);
+  CHECK(c.draws == 13);
+
+  r1.counter().reset_counts();
+  CHECK(c.draws == 0);
+  CHECK(c.seeds == 0);
+
+  // Conversions between the policies keep the state.
+  tinymt32 r3(r1);
+  CHECK(r3() == r1());
+  const tinymt32_counted<> r4(r3);
+  CHECK(r4.counter().counts().seeds == 0);
+  CHECK(tinymt32(r4) == r3);
+}
+
+TEST_CASE("jumps") {
+  tinymt32_counted<> r(42);
+  const engine_counts& c = r.counter().counts();
+  r.advance_pow2(10);
+  CHECK(c.discarded == 1024);
+  // Saturated.
+  r.advance_pow2(100);
+  CHECK(c.discarded == max_count);
+  r.discard(1);
+  CHECK(c.discarded == max_count);
+
+  // Counted for the returned engine.
+  r.counter().reset_counts();
+  const tinymt32_counted<> e0 = r.split(0, 4);
+  const tinymt32_counted<> e1 = r.split(1, 4);
+  CHECK(c.discarded == 0);
+  CHECK(e0.counter().counts().discarded == 0);
+  CHECK(e1.counter().counts().discarded == max_count);
+
+  // Steps back are not counted.
+  r();
+  r.step_back();
+  r.rewind(10);
+  CHECK(c.draws == 1);
+  CHECK(c.discarded == 0);
+}
+
+TEST_CASE("seed_many") {
+  const tinymt32_dc::param_type param = {0x8f7011eeU, 0xfc78ff1fU,
+                                         0x3793fdffU};
+  vector<tinymt32_dc_counted<>> engines(3, tinymt32_dc_counted<>(param));
+  const vector<tinymt32_dc::param_type> params(3, param);
+  const vector<uint_fast32_t> seeds = {1U, 2U, 3U};
+  tinymt32_dc_counted<>::seed_many(engines.data(), params.data(),
+                                   seeds.data(), 3);
+  for (const auto& e : engines) {
+    CHECK(e.counter().counts().seeds == 2);
+  }
+  CHECK(engines[2] == tinymt32_dc_counted<>(param, 3));
+}
+
+TEST_CASE("counter_registry") {
+  counter_registry& registry = counter_registry::global();
+  registry.reset();
+
+  auto work = [](uint_fast64_t seed, int n) {
+    tinymt64_counted<registry_counter> r(seed);
+    for (int i = 0; i < n; i++) {
+      r();
+    }
+    r.discard(5);
+    vector<uint_fast64_t> x(10);
+    r.fill(x.data(), x.size());
+  };
+
+  work(1, 100);
+  thread t1(work, 2, 200);
+  t1.join();
+  thread t2(work, 3, 300);
+  t2.join();
+
+  const vector<counter_registry::thread_counts> v = registry.per_thread();
+  REQUIRE(v.size() == 3);
+  CHECK(v[0].thread == this_thread::get_id());
+  CHECK(v[0].counts.draws == 100);
+  CHECK(v[1].counts.draws == 200);
+  CHECK(v[2].counts.draws == 300);
+
+  const engine_counts c = registry.total();
+  CHECK(c.draws == 600);
+  CHECK(c.discarded == 15);
+  CHECK(c.seeds == 3);
+  CHECK(c.filled == 30);
+
+  ostringstream os;
+  registry.dump(os);
+  const string s = os.str();
+  CHECK(s.find("thread 2 (") != string::npos);
+  CHECK(s.find("total: draws 600, discarded 15, seeds 3, filled 30\n") !=
+        string::npos);
+
+  registry.reset();
+  CHECK(registry.total().draws == 0);
+
+  // Saturated, also in the total.
+  auto jump = [](int n) {
+    tinymt64_counted<registry_counter> r(1);
+    for (int i = 0; i < n; i++) {
+      r.advance_pow2(63);
+    }
+  };
+  jump(1);
+  thread t3(jump, 2);
+  t3.join();
+  CHECK(registry.per_thread()[0].counts.discarded == 1ULL << 63);
+  CHECK(registry.per_thread()[3].counts.discarded == max_count);
+  CHECK(registry.total().discarded == max_count);
+  registry.reset();
+}
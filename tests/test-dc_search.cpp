@@ -0,0 +1,97 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest/doctest.h>
+#include <tinymt/dc_search.h>
+
+#include <set>
+
+using namespace std;
+using namespace tinymt;
+
+using impl = detail::tinymt32_equidistribution::impl;
+
+TEST_CASE("characteristic") {
+  // tinymt32dc.0.1048576.txt.1, i.e., RFC 8682:
+  // d8524022ed8dff4a8dcc50c798faba43,32,0,8f7011ee,fc78ff1f,3793fdff,63,0
+  impl::status_type s;
+  s.mat1 = 0x8f7011eeU;
+  s.mat2 = 0xfc78ff1fU;
+  s.tmat = 0x3793fdffU;
+  detail::f2_polynomial p = impl::characteristic_polynomial(s);
+  CHECK(p.coef[0] == 0x8dcc50c798faba43U);
+  CHECK(p.coef[1] == 0xd8524022ed8dff4aU);
+  CHECK(detail::f2_is_primitive(p));
+  CHECK(detail::dc_search_weight(p) == 63);
+
+  detail::tinymt32_equidistribution eq({s.mat1, s.mat2, 0});
+  CHECK(eq.delta(0x3793fdffU) == 0);
+  CHECK(eq.delta(0) > 0);
+
+  // tinymt32dc.1.1048576.txt:1
+  detail::tinymt32_equidistribution eq1({0xda251b45U, 0xfed0ffb5U, 0});
+  CHECK(eq1.delta(0x9b5cf7ffU) == 0);
+
+  // A reducible polynomial.
+  s.mat2 = 0;
+  CHECK(!detail::f2_is_primitive(impl::characteristic_polynomial(s)));
+}
+
+TEST_CASE("search") {
+  tinymt32_dc_search_result r = find_tinymt32_dc_param(7);
+  CHECK(r.id == 7);
+  CHECK(r.delta == 0);
+
+  impl::status_type s;
+  s.mat1 = static_cast<uint_least32_t>(r.param.mat1);
+  s.mat2 = static_cast<uint_least32_t>(r.param.mat2);
+  s.tmat = static_cast<uint_least32_t>(r.param.tmat);
+  detail::f2_polynomial p = impl::characteristic_polynomial(s);
+  CHECK(p.coef == r.characteristic);
+  CHECK(detail::f2_is_primitive(p));
+
+  CHECK(r.weight == detail::dc_search_weight(p));
+
+  detail::tinymt32_equidistribution eq(r.param);
+  CHECK(eq.delta(r.param.tmat) == 0);
+
+  // Usable as a parameter set.
+  tinymt32_dc r1(r.param);
+  tinymt32_dc r2(r.param);
+  r1.discard(2000);
+  for (int i = 0; i < 2000; i++) {
+    r2();
+  }
+  CHECK(r1 == r2);
+
+  // Deterministic and seed-dependent.
+  tinymt32_dc_search_result r3 = find_tinymt32_dc_param(7);
+  CHECK(r3.param.mat1 == r.param.mat1);
+  CHECK(r3.param.mat2 == r.param.mat2);
+  CHECK(r3.param.tmat == r.param.tmat);
+  tinymt32_dc_search_result r4 = find_tinymt32_dc_param(7, 1);
+  CHECK(r4.param.mat1 != r.param.mat1);
+}
+
+TEST_CASE("threads") {
+  vector<tinymt32_dc_search_result> v1 = find_tinymt32_dc_params(100, 6, 1);
+  vector<tinymt32_dc_search_result> v2 = find_tinymt32_dc_params(100, 6, 4);
+  vector<tinymt32_dc_search_result> v3 = find_tinymt32_dc_params(100, 6);
+  REQUIRE(v1.size() == 6);
+  REQUIRE(v2.size() == 6);
+  REQUIRE(v3.size() == 6);
+
+  set<uint_least32_t> mat1s;
+  for (size_t i = 0; i < v1.size(); i++) {
+    CHECK(v1[i].id == 100 + i);
+    CHECK(v1[i].param.mat1 == v2[i].param.mat1);
+    CHECK(v1[i].param.mat2 == v2[i].param.mat2);
+    CHECK(v1[i].param.tmat == v2[i].param.tmat);
+    CHECK(v1[i].param.tmat == v3[i].param.tmat);
+    mat1s.insert(static_cast<uint_least32_t>(v1[i].param.mat1));
+  }
+  CHECK(mat1s.size() == v1.size());
+
+  tinymt32_dc_search_result r = find_tinymt32_dc_param(103);
+  CHECK(r.param.mat2 == v1[3].param.mat2);
+
+  CHECK(find_tinymt32_dc_params(0, 0).empty());
+}
@@ -9,4 +9,13 @@ template class tinymt::tinymt_engine<
 
 template class tinymt::tinymt_engine<std::uint_fast32_t, 32, 0, 0, 0>;
 
+template class tinymt::tinymt_engine<
+    std::uint_fast64_t, 64, tinymt::detail::tinymt64_default_param_mat1,
+    tinymt::detail::tinymt64_default_param_mat2,
+    tinymt::detail::tinymt64_default_param_tmat>;
+
+template class tinymt::tinymt_engine<std::uint_fast64_t, 64, 0, 0, 0>;
+
+template class tinymt::tinymt_engine_array<std::uint_fast32_t, 32, 8>;
+
 int main() { return 0; }
@@ -0,0 +1,128 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest/doctest.h>
+#include <tinymt/tinymt.h>
+
+#include <cstring>
+#include <random>
+#include <vector>
+
+using namespace std;
+using namespace tinymt;
+
+namespace {
+
+// Exact comparison of floating-point numbers.
+template <typename T>
+bool same(T x, T y) {
+  return memcmp(&x, &y, sizeof(T)) == 0;
+}
+
+}  // namespace
+
+TEST_CASE("tinymt32") {
+  // Not a multiple of the block size.
+  const size_t n = 1000;
+
+  tinymt32 r1(42);
+  tinymt32 r2(42);
+  vector<float> x(n);
+  fill_uniform(x.data(), n, r1);
+  for (size_t i = 0; i < n; i++) {
+    CHECK_MESSAGE(same(x[i], r2.generate_float01()), "i = " << i);
+  }
+
+  vector<double> y(n);
+  fill_uniform(y.data(), n, r1);
+  for (size_t i = 0; i < n; i++) {
+    CHECK_MESSAGE(same(y[i], r2.generate_32double()), "i = " << i);
+  }
+
+  CHECK(r1 == r2);
+}
+
+TEST_CASE("tinymt32_dc") {
+  const size_t n = 1000;
+  const tinymt32_dc::param_type param = {0x8f7011eeU, 0xfc78ff1fU,
+                                         0x3793fdffU};
+
+  tinymt32_dc r1(param, 42);
+  tinymt32_dc r2(param, 42);
+  vector<float> x(n);
+  fill_uniform(x.data(), n, r1, -1.0f, 3.0f);
+  for (size_t i = 0; i < n; i++) {
+    const float u = r2.generate_float01();
+    CHECK_MESSAGE(same(x[i], -1.0f + 4.0f * u), "i = " << i);
+    CHECK(x[i] >= -1.0f);
+    CHECK(x[i] < 3.0f);
+  }
+}
+
+TEST_CASE("tinymt64") {
+  const size_t n = 1000;
+
+  tinymt64 r1(42);
+  tinymt64 r2(42);
+  vector<double> y(n);
+  fill_uniform(y.data(), n, r1, 10.0, 20.0);
+  for (size_t i = 0; i < n; i++) {
+    const double u = r2.generate_double01();
+    CHECK_MESSAGE(same(y[i], 10.0 + 10.0 * u), "i = " << i);
+  }
+
+  vector<float> x(n);
+  fill_uniform(x.data(), n, r1);
+  for (size_t i = 0; i < n; i++) {
+    const float u = static_cast<float>(r2() >> 41) * (1.0f / 8388608.0f);
+    CHECK_MESSAGE(same(x[i], u), "i = " << i);
+  }
+}
+
+TEST_CASE("std engine") {
+  const size_t n = 1000;
+
+  mt19937 r1(42);
+  mt19937 r2(42);
+  vector<double> y(n);
+  fill_uniform(y.data(), n, r1);
+  for (size_t i = 0; i < n; i++) {
+    const double u = static_cast<double>(r2()) * (1.0 / 4294967296.0);
+    CHECK_MESSAGE(same(y[i], u), "i = " << i);
+  }
+}
+
+TEST_CASE("generate_transform") {
+  // Large enough for the substreams, and not a multiple of their number.
+  const size_t n = 8 * 20000 * 2 + 13;
+
+  auto check = [n](tinymt32_dc r1) {
+    tinymt32_dc r2 = r1;
+    vector<uint_least32_t> x(n);
+    r1.generate_transform(x.data(), n, [](uint_fast32_t w) {
+      return static_cast<uint_least32_t>(w);
+    });
+    size_t i = 0;
+    for (; i < n; i++) {
+      if (x[i] != r2()) {
+        break;
+      }
+    }
+    CHECK(i == n);
+    CHECK(r1 == r2);
+  };
+
+  check(tinymt32_dc({0x8f7011eeU, 0xfc78ff1fU, 0x3793fdffU}, 42));
+  check(tinymt32_dc({0xda251b45U, 0xfed0ffb5U, 0x9b5cf7ffU}, 1));
+
+  tinymt32 r1(42);
+  tinymt32 r2(42);
+  vector<float> x(n);
+  fill_uniform(x.data(), n, r1);
+  size_t i = 0;
+  for (; i < n; i++) {
+    if (!same(x[i], r2.generate_float01())) {
+      break;
+    }
+  }
+  CHECK(i == n);
+  CHECK(r1 == r2);
+}
@@ -1,6 +1,13 @@
-// Check if including the header file doesn't make any mess; it must be
+// Check if including the header files doesn't make any mess; it must be
 // successfully compiled.
 
+#include <tinymt/counter_registry.h>
+#include <tinymt/dc_search.h>
+#include <tinymt/mapped_file.h>
+#include <tinymt/parallel_fill.h>
+#include <tinymt/param_db.h>
+#include <tinymt/population.h>
+#include <tinymt/thread_engine_pool.h>
 #include <tinymt/tinymt.h>
 
 int main() { return 0; }
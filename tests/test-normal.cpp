@@ -0,0 +1,105 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest/doctest.h>
+#include <tinymt/tinymt.h>
+
+#include <cmath>
+#include <cstring>
+#include <random>
+#include <vector>
+
+using namespace std;
+using namespace tinymt;
+
+namespace {
+
+template <typename T>
+bool same(T x, T y) {
+  return memcmp(&x, &y, sizeof(T)) == 0;
+}
+
+template <typename Rng>
+void check_moments(Rng& r, double mean, double stddev) {
+  tinymt::normal_distribution<> dist(mean, stddev);
+
+  const int n = 1000000;
+  double s1 = 0;
+  double s2 = 0;
+  int outliers = 0;
+  for (int i = 0; i < n; i++) {
+    double x = dist(r);
+    REQUIRE(std::isfinite(x));
+    double z = (x - mean) / stddev;
+    s1 += z;
+    s2 += z * z;
+    if (std::fabs(z) > 3.6541528853610088) {
+      outliers++;
+    }
+  }
+  double m = s1 / n;
+  double v = s2 / n - m * m;
+  CHECK(std::fabs(m) < 0.005);
+  CHECK(std::fabs(v - 1) < 0.01);
+  // P(|z| > r) is about 2.6e-4: the tail must be sampled too.
+  CHECK(outliers > 150);
+  CHECK(outliers < 400);
+}
+
+}  // namespace
+
+TEST_CASE("moments") {
+  tinymt32 r32;
+  check_moments(r32, 0, 1);
+  check_moments(r32, -3, 0.5);
+
+  tinymt64 r64;
+  check_moments(r64, 10, 2);
+}
+
+TEST_CASE("param") {
+  tinymt::normal_distribution<float> dist1;
+  CHECK(same(dist1.mean(), 0.0f));
+  CHECK(same(dist1.stddev(), 1.0f));
+
+  tinymt::normal_distribution<float> dist2(1, 2);
+  CHECK(same(dist2.mean(), 1.0f));
+  CHECK(same(dist2.stddev(), 2.0f));
+  CHECK(dist1 != dist2);
+
+  dist1.param(dist2.param());
+  CHECK(dist1 == dist2);
+
+  tinymt32 r;
+  float x = dist2(r);
+  CHECK(std::isfinite(x));
+}
+
+TEST_CASE("generate") {
+  tinymt32 r1;
+  tinymt32 r2;
+  tinymt::normal_distribution<> dist(1, 3);
+
+  // Longer than the internal buffer.
+  vector<double> x(1000);
+  dist.generate(x.begin(), x.end(), r1);
+  for (double y : x) {
+    CHECK(same(y, dist(r2)));
+  }
+  CHECK(r1 == r2);
+
+  vector<float> y(77);
+  fill_normal(y.data(), y.size(), r1, 1.0f, 3.0f);
+  tinymt::normal_distribution<float> fdist(1, 3);
+  for (float z : y) {
+    CHECK(same(z, fdist(r2)));
+  }
+  CHECK(r1 == r2);
+
+  // Generators without generate().
+  mt19937 r3;
+  mt19937 r4;
+  dist.generate(x.begin(), x.end(), r3);
+  for (double z : x) {
+    CHECK(same(z, dist(r4)));
+  }
+  CHECK(r3 == r4);
+}
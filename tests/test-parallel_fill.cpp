@@ -0,0 +1,103 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest/doctest.h>
+#include <tinymt/counter_registry.h>
+#include <tinymt/parallel_fill.h>
+
+#include <cstdint>
+#include <deque>
+#include <thread>
+#include <vector>
+
+using namespace std;
+using namespace tinymt;
+
+namespace {
+
+// Not a multiple of the block size.
+const size_t n = 3 * detail::parallel_fill_block_size + 12345;
+
+template <class T, class Engine>
+vector<T> sequential(Engine& r, size_t size) {
+  vector<T> v(size);
+  for (T& x : v) {
+    x = static_cast<T>(r());
+  }
+  return v;
+}
+
+}  // namespace
+
+TEST_CASE("tinymt32") {
+  tinymt32 r0(42);
+  const vector<uint_least32_t> expected = sequential<uint_least32_t>(r0, n);
+
+  for (size_t threads : {1U, 2U, 3U, 8U, 0U}) {
+    tinymt32 r(42);
+    vector<uint_least32_t> v(n);
+    parallel_fill(v.data(), v.data() + v.size(), r, threads);
+    CHECK_MESSAGE(v == expected, "threads = " << threads);
+    CHECK(r == r0);
+  }
+
+  // Small ranges.
+  tinymt32 r1(1);
+  tinymt32 r2(1);
+  vector<uint_least32_t> v(100);
+  parallel_fill(v.data(), v.data() + v.size(), r1, 4);
+  CHECK(v == sequential<uint_least32_t>(r2, v.size()));
+  CHECK(r1 == r2);
+}
+
+TEST_CASE("tinymt32_dc") {
+  const tinymt32_dc::param_type param = {0x8f7011eeU, 0xfc78ff1fU,
+                                         0x3793fdffU};
+  tinymt32_dc r0(param, 7);
+  const vector<uint_fast32_t> expected = sequential<uint_fast32_t>(r0, n);
+
+  tinymt32_dc r(param, 7);
+  vector<uint_fast32_t> v(n);
+  parallel_fill(v.data(), v.data() + v.size(), r, 3);
+  CHECK(v == expected);
+  CHECK(r == r0);
+}
+
+TEST_CASE("tinymt64") {
+  // Iterators, not pointers.
+  tinymt64 r0(42);
+  const vector<uint_least64_t> expected = sequential<uint_least64_t>(r0, n);
+
+  tinymt64 r(42);
+  deque<uint_least64_t> v(n);
+  parallel_fill(v.begin(), v.end(), r, 4);
+  CHECK(equal(v.begin(), v.end(), expected.begin()));
+  CHECK(r == r0);
+}
+
+TEST_CASE("counters") {
+  // The range counts as filled by the engine.
+  tinymt32 r0(42);
+  tinymt32_counted<> r1(42);
+  vector<uint_least32_t> v(n);
+  parallel_fill(v.data(), v.data() + v.size(), r1, 3);
+  r0.discard(n);
+  CHECK(r1() == r0());
+  const engine_counts& c = r1.counter().counts();
+  CHECK(c.filled == n);
+  CHECK(c.discarded == 0);
+  CHECK(c.draws == 1);
+  CHECK(c.seeds == 1);
+
+  // Also in the registry, for the calling thread only.
+  counter_registry& registry = counter_registry::global();
+  registry.reset();
+  tinymt32_counted<registry_counter> r2(42);
+  parallel_fill(v.data(), v.data() + v.size(), r2, 3);
+  const engine_counts total = registry.total();
+  CHECK(total.filled == n);
+  CHECK(total.discarded == 0);
+  for (const counter_registry::thread_counts& t : registry.per_thread()) {
+    if (t.thread == this_thread::get_id()) {
+      CHECK(t.counts.filled == n);
+    }
+  }
+}
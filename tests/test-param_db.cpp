@@ -0,0 +1,140 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest/doctest.h>
+#include <tinymt/param_db.h>
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+using namespace std;
+using namespace tinymt;
+
+namespace {
+
+// Parameter sets taken from https://github.com/jj1bdx/tinymtdc-longbatch/, with
+// the IDs renumbered. Only the first line has the genuine characteristic
+// polynomial, weight and delta, which the conversion ignores.
+const char* const text =
+    "# characteristic, type, id, mat1, mat2, tmat, weight, delta\n"
+    "d8524022ed8dff4a8dcc50c798faba43,32,11,8f7011ee,fc78ff1f,3793fdff,63,0\n"
+    "\n"
+    "a0c6e5b1e6f7e2a55a0cd1f8a3b83a75,32,13,f20d1e43,ff90ffe5,dd372f7f,67,0\n"
+    "b3e3b2d5e83b3f1ae0a2e9f8bd3a1a21,32,12,da251b45,fed0ffb5,9b5cf7ff,59,0\n";
+
+const char* const db_file = "test-param_db.bin";
+
+bool same(const tinymt32_dc::param_type& a, const tinymt32_dc::param_type& b) {
+  return a.mat1 == b.mat1 && a.mat2 == b.mat2 && a.tmat == b.tmat;
+}
+
+void write_file(const string& data) {
+  ofstream os(db_file, ios::binary);
+  os << data;
+}
+
+}  // namespace
+
+TEST_CASE("convert") {
+  {
+    istringstream is(text);
+    ofstream os(db_file, ios::binary);
+    tinymt32_dc_param_db::convert(is, os);
+  }
+
+  tinymt32_dc_param_db db(db_file);
+  CHECK(db.first_id() == 11);
+  CHECK(db.size() == 3);
+  CHECK(!db.contains(10));
+  CHECK(db.contains(11));
+  CHECK(db.contains(13));
+  CHECK(!db.contains(14));
+  CHECK(same(db[11], {0x8f7011eeU, 0xfc78ff1fU, 0x3793fdffU}));
+  CHECK(same(db[12], {0xda251b45U, 0xfed0ffb5U, 0x9b5cf7ffU}));
+  CHECK(same(db.at(13), {0xf20d1e43U, 0xff90ffe5U, 0xdd372f7fU}));
+  CHECK_THROWS_AS(db.at(14), out_of_range);
+  CHECK_THROWS_AS(db.at(0), out_of_range);
+
+  // The engine works with the parameter set.
+  tinymt32_dc r1(db[11]);
+  tinymt32 r2;
+  for (int i = 0; i < 100; i++) {
+    CHECK(r1() == r2());
+  }
+}
+
+TEST_CASE("renumber") {
+  {
+    istringstream is(text);
+    ofstream os(db_file, ios::binary);
+    tinymt32_dc_param_db::convert(is, os, 1000);
+  }
+
+  tinymt32_dc_param_db db(db_file);
+  CHECK(db.first_id() == 1000);
+  CHECK(db.size() == 3);
+  CHECK(same(db[1000], {0x8f7011eeU, 0xfc78ff1fU, 0x3793fdffU}));
+  CHECK(same(db[1001], {0xf20d1e43U, 0xff90ffe5U, 0xdd372f7fU}));
+  CHECK(same(db[1002], {0xda251b45U, 0xfed0ffb5U, 0x9b5cf7ffU}));
+}
+
+TEST_CASE("write") {
+  vector<tinymt32_dc::param_type> params(3000);
+  for (size_t i = 0; i < params.size(); i++) {
+    auto x = static_cast<uint_least32_t>(i);
+    params[i] = {x, x * 3, 0xffffffffU - x};
+  }
+  {
+    ofstream os(db_file, ios::binary);
+    tinymt32_dc_param_db::write(os, 0xfffff000U, params.data(), params.size());
+  }
+
+  tinymt32_dc_param_db db(db_file);
+  CHECK(db.size() == 3000);
+  for (size_t i = 0; i < params.size(); i++) {
+    auto id = static_cast<uint_least32_t>((0xfffff000U + i) & 0xffffffffU);
+    REQUIRE(db.contains(id));
+    CHECK(same(db[id], params[i]));
+  }
+  CHECK(!db.contains(0xffffefffU));
+}
+
+TEST_CASE("errors") {
+  istringstream bad1("d8524022,32,0,8f7011ee,fc78ff1f\n");
+  ostringstream os;
+  CHECK_THROWS_AS(tinymt32_dc_param_db::convert(bad1, os), runtime_error);
+
+  istringstream bad2("d8524022,64,0,8f7011ee,fc78ff1f,3793fdff,63,0\n");
+  CHECK_THROWS_AS(tinymt32_dc_param_db::convert(bad2, os), runtime_error);
+
+  istringstream bad3("d8524022,32,0,8f7011ee,fc78ff1g,3793fdff,63,0\n");
+  CHECK_THROWS_AS(tinymt32_dc_param_db::convert(bad3, os), runtime_error);
+
+  istringstream gap(
+      "d8524022,32,0,8f7011ee,fc78ff1f,3793fdff,63,0\n"
+      "d8524022,32,2,8f7011ee,fc78ff1f,3793fdff,63,0\n");
+  CHECK_THROWS_AS(tinymt32_dc_param_db::convert(gap, os), runtime_error);
+
+  istringstream dup(
+      "d8524022,32,0,8f7011ee,fc78ff1f,3793fdff,63,0\n"
+      "d8524022,32,0,8f7011ee,fc78ff1f,3793fdff,63,0\n");
+  CHECK_THROWS_AS(tinymt32_dc_param_db::convert(dup, os), runtime_error);
+
+  CHECK_THROWS_AS(tinymt32_dc_param_db{"no-such-file.bin"}, runtime_error);
+
+  write_file("not a database, but long enough for the header");
+  CHECK_THROWS_AS(tinymt32_dc_param_db{db_file}, runtime_error);
+
+  // Truncated.
+  {
+    vector<tinymt32_dc::param_type> params(2);
+    ostringstream ss;
+    tinymt32_dc_param_db::write(ss, 0, params.data(), params.size());
+    string data = ss.str();
+    CHECK(data.size() == 32 + 2 * 12);
+    write_file(data.substr(0, data.size() - 1));
+  }
+  CHECK_THROWS_AS(tinymt32_dc_param_db{db_file}, runtime_error);
+
+  remove(db_file);
+}
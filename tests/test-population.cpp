@@ -0,0 +1,156 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest/doctest.h>
+#include <tinymt/population.h>
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace tinymt;
+
+namespace {
+
+const char* const snapshot_file = "test-population.bin";
+
+const tinymt32_dc::param_type dc_params[] = {
+    {0x8f7011eeU, 0xfc78ff1fU, 0x3793fdffU},
+    {0xda251b45U, 0xfed0ffb5U, 0x9b5cf7ffU},
+    {0xf20d1e43U, 0xff90ffe5U, 0xdd372f7fU}};
+
+void write_file(const string& data) {
+  ofstream os(snapshot_file, ios::binary);
+  os << data;
+}
+
+template <class Engine>
+string write_snapshot(const vector<Engine>& engines,
+                      const uint_least32_t* ids = nullptr) {
+  ostringstream ss;
+  population_snapshot<Engine>::write(ss, engines.data(), ids, engines.size());
+  write_file(ss.str());
+  return ss.str();
+}
+
+vector<tinymt32> make_engines(size_t n) {
+  vector<tinymt32> engines;
+  for (size_t i = 0; i < n; i++) {
+    engines.emplace_back(static_cast<uint_least32_t>(i));
+    engines.back().discard(i % 7);
+  }
+  return engines;
+}
+
+vector<tinymt32_dc> make_dc_engines(size_t n, vector<uint_least32_t>& ids) {
+  vector<tinymt32_dc> engines;
+  for (size_t i = 0; i < n; i++) {
+    ids.push_back(static_cast<uint_least32_t>(i % 3));
+    engines.emplace_back(dc_params[ids.back()],
+                         static_cast<uint_least32_t>(i));
+  }
+  return engines;
+}
+
+}  // namespace
+
+TEST_CASE("tinymt32") {
+  // More than the buffer of the writer.
+  const size_t n = 3000;
+  const vector<tinymt32> engines = make_engines(n);
+  const string data = write_snapshot(engines);
+  CHECK(data.size() == 64 + 16 * n + 8);
+
+  population_snapshot<tinymt32> snap(snapshot_file);
+  CHECK(snap.size() == n);
+  CHECK(!snap.has_params());
+  CHECK(!snap.has_ids());
+  CHECK(snap.verify());
+  for (size_t i = 0; i < n; i++) {
+    CHECK_MESSAGE(snap[i] == engines[i], "i = " << i);
+  }
+
+  lazy_population<tinymt32> pop(snapshot_file);
+  CHECK(pop.size() == n);
+  CHECK(pop[10] == engines[10]);
+  // The engine stays and keeps its state.
+  tinymt32 r = engines[10];
+  CHECK(pop[10]() == r());
+  CHECK(pop[10] == r);
+  pop.materialize_all();
+  for (size_t i = 0; i < n; i++) {
+    if (i != 10) {
+      CHECK_MESSAGE(pop[i] == engines[i], "i = " << i);
+    }
+  }
+}
+
+TEST_CASE("tinymt32_dc") {
+  const size_t n = 1001;
+  vector<uint_least32_t> ids;
+  const vector<tinymt32_dc> engines = make_dc_engines(n, ids);
+
+  // With the parameter column.
+  write_snapshot(engines);
+  {
+    population_snapshot<tinymt32_dc> snap(snapshot_file);
+    CHECK(snap.size() == n);
+    CHECK(snap.has_params());
+    CHECK(!snap.has_ids());
+    CHECK(snap.verify());
+    for (size_t i = 0; i < n; i++) {
+      CHECK_MESSAGE(snap[i] == engines[i], "i = " << i);
+    }
+    lazy_population<tinymt32_dc> pop(snapshot_file);
+    CHECK(pop[n - 1] == engines[n - 1]);
+  }
+
+  // With the ID column instead.
+  const string data = write_snapshot(engines, ids.data());
+  CHECK(data.size() == 64 + 20 * n + 8);
+  {
+    population_snapshot<tinymt32_dc> snap(snapshot_file);
+    CHECK(!snap.has_params());
+    CHECK(snap.has_ids());
+    CHECK(snap.verify());
+    CHECK_THROWS_AS(snap[0], runtime_error);
+    for (size_t i = 0; i < n; i++) {
+      CHECK(snap.id(i) == ids[i]);
+      CHECK_MESSAGE(snap.get(i, dc_params) == engines[i], "i = " << i);
+    }
+    lazy_population<tinymt32_dc> pop(
+        snapshot_file, [](uint_least32_t id) { return dc_params[id]; });
+    CHECK(pop[5] == engines[5]);
+  }
+}
+
+TEST_CASE("errors") {
+  const vector<tinymt32> engines = make_engines(3);
+  string data = write_snapshot(engines);
+
+  // Corrupted data is found only by the checksum.
+  data[64 + 5] = static_cast<char>(data[64 + 5] ^ 1);
+  write_file(data);
+  {
+    population_snapshot<tinymt32> snap(snapshot_file);
+    CHECK(!snap.verify());
+  }
+
+  // Truncated.
+  write_file(data.substr(0, data.size() - 1));
+  CHECK_THROWS_AS(population_snapshot<tinymt32>{snapshot_file}, runtime_error);
+
+  // Different engines.
+  write_snapshot(engines);
+  CHECK_THROWS_AS(population_snapshot<tinymt32_dc>{snapshot_file},
+                  runtime_error);
+
+  CHECK_THROWS_AS(population_snapshot<tinymt32>{"no-such-file.bin"},
+                  runtime_error);
+
+  write_file(string(100, 'x'));
+  CHECK_THROWS_AS(population_snapshot<tinymt32>{snapshot_file}, runtime_error);
+
+  remove(snapshot_file);
+}
@@ -0,0 +1,108 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest/doctest.h>
+#include <tinymt/tinymt.h>
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace tinymt;
+
+namespace {
+
+template <typename Rng>
+void check_round_trip(Rng r) {
+  r.discard(12345);
+
+  // Binary form.
+  const size_t size = Rng::serialized_size;
+  vector<unsigned char> buf(size);
+  r.save(buf.data());
+  Rng r2 = r;
+  r2.discard(1);
+  REQUIRE(r2 != r);
+  r2.load(buf.data());
+  CHECK(r2 == r);
+
+  // Text form, compatible with the stream operators.
+  ostringstream os;
+  os << r;
+  const string text = os.str();
+  const size_t max_chars = Rng::max_chars;
+  CHECK(text.size() <= max_chars);
+
+  vector<char> chars(max_chars);
+  char* end = r.to_chars(chars.data(), chars.data() + chars.size());
+  REQUIRE(end != nullptr);
+  CHECK(string(chars.data(), end) == text);
+  CHECK(r.to_chars(chars.data(), chars.data() + text.size() - 1) == nullptr);
+
+  Rng r3 = r;
+  r3.discard(1);
+  const char* p = r3.from_chars(text.data(), text.data() + text.size());
+  CHECK(p == text.data() + text.size());
+  CHECK(r3 == r);
+
+  Rng r4 = r;
+  r4.discard(1);
+  istringstream is(text);
+  is >> r4;
+  CHECK(r4 == r);
+
+  CHECK(r() == r3());
+}
+
+template <typename Rng>
+void check_bad_text(Rng r) {
+  const Rng r0 = r;
+  const string bad[] = {"", "1 2", "1 x 3 4 5 6 7", "-1 2 3 4 5 6 7",
+                        "99999999999999999999999 2 3 4 5 6 7"};
+  for (const string& s : bad) {
+    CHECK_MESSAGE(r.from_chars(s.data(), s.data() + s.size()) == nullptr,
+                  "s = " << s);
+    CHECK(r == r0);
+  }
+}
+
+}  // namespace
+
+static_assert(tinymt32::serialized_size == 16, "");
+static_assert(tinymt32_dc::serialized_size == 28, "");
+static_assert(tinymt64::serialized_size == 16, "");
+static_assert(tinymt64_dc::serialized_size == 32, "");
+
+TEST_CASE("round trip") {
+  check_round_trip(tinymt32(42));
+  check_round_trip(tinymt32_dc({0x8f7011ee, 0xfc78ff1f, 0x3793fdff}, 42));
+  check_round_trip(tinymt64(42));
+  const tinymt64_dc::param_type param64 = {0xfa051f40, 0xffd0fff4,
+                                           0x58d02ffeffbfffbc};
+  check_round_trip(tinymt64_dc(param64, 42));
+  check_bad_text(tinymt32(42));
+  check_bad_text(tinymt64_dc(param64, 42));
+}
+
+TEST_CASE("binary layout") {
+  tinymt32_dc r({0x8f7011ee, 0xfc78ff1f, 0x3793fdff}, 1);
+  unsigned char buf[tinymt32_dc::serialized_size];
+  r.save(buf);
+  // mat1, mat2 and tmat in little-endian byte order after the state.
+  const unsigned char param[] = {0xee, 0x11, 0x70, 0x8f, 0x1f, 0xff,
+                                 0x78, 0xfc, 0xff, 0xfd, 0x93, 0x37};
+  for (size_t i = 0; i < sizeof(param); i++) {
+    CHECK_MESSAGE(buf[16 + i] == param[i], "i = " << i);
+  }
+
+  tinymt32_dc r2({1, 2, 3}, 7);
+  r2.load(buf);
+  CHECK(r2 == r);
+
+  ostringstream os;
+  os << r;
+  const string text = "  " + os.str() + " rest";
+  tinymt32_dc r3({1, 2, 3}, 7);
+  const char* p = r3.from_chars(text.data(), text.data() + text.size());
+  CHECK(string(p) == " rest");
+  CHECK(r3 == r);
+}
@@ -0,0 +1,140 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest/doctest.h>
+#include <tinymt/tinymt.h>
+
+#include <algorithm>
+#include <map>
+#include <numeric>
+#include <set>
+#include <vector>
+
+using namespace std;
+using namespace tinymt;
+
+namespace {
+
+bool is_permutation_of_iota(vector<uint32_t> v) {
+  sort(v.begin(), v.end());
+  for (size_t i = 0; i < v.size(); i++) {
+    if (v[i] != i) {
+      return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace
+
+TEST_CASE("shuffle") {
+  // Sizes around the boundary of the paired indices.
+  for (size_t n : {0U, 1U, 2U, 3U, 100U, 65535U, 65536U, 65537U, 200001U}) {
+    vector<uint32_t> v(n);
+    iota(v.begin(), v.end(), 0);
+    tinymt32 r1(42);
+    tinymt::shuffle(v.begin(), v.end(), r1);
+    CHECK_MESSAGE(is_permutation_of_iota(v), "n = " << n);
+
+    // Deterministic, and independent of the type of the iterators.
+    vector<uint32_t> w(n);
+    random_permutation(w.data(), w.data() + n, r1 = tinymt32(42));
+    CHECK_MESSAGE(v == w, "n = " << n);
+
+    tinymt32 r2(42);
+    vector<uint32_t> u(n);
+    random_permutation(u.begin(), u.end(), r2);
+    CHECK(r1 == r2);
+  }
+
+  tinymt64 r(1);
+  vector<uint32_t> v(70000);
+  random_permutation(v.begin(), v.end(), r);
+  CHECK(is_permutation_of_iota(v));
+}
+
+TEST_CASE("shuffle (uniformity)") {
+  // All 24 permutations of 4 elements, with the paired indices.
+  const int trials = 240000;
+  map<vector<int>, int> count;
+  tinymt32 r(1);
+  for (int t = 0; t < trials; t++) {
+    vector<int> v = {0, 1, 2, 3};
+    tinymt::shuffle(v.begin(), v.end(), r);
+    count[v]++;
+  }
+  CHECK(count.size() == 24);
+  for (const auto& c : count) {
+    // The standard deviation is about 98.
+    CHECK(abs(c.second - trials / 24) < 500);
+  }
+
+  // Position of the first element, with single indices.
+  const size_t n = 65540;
+  vector<int> hits(4);
+  for (int t = 0; t < 4000; t++) {
+    vector<uint32_t> v(n);
+    random_permutation(v.begin(), v.end(), r);
+    const size_t pos = static_cast<size_t>(find(v.begin(), v.end(), 0U) -
+                                           v.begin());
+    hits[pos * 4 / n]++;
+  }
+  for (int h : hits) {
+    CHECK(abs(h - 1000) < 150);
+  }
+}
+
+TEST_CASE("sample_without_replacement (Floyd)") {
+  tinymt32 r(42);
+  for (uint64_t k : {0U, 1U, 10U, 100U, 1000U}) {
+    vector<uint64_t> v;
+    sample_without_replacement(1000, k, back_inserter(v), r);
+    CHECK(v.size() == k);
+    set<uint64_t> s(v.begin(), v.end());
+    CHECK(s.size() == k);
+    CHECK((k == 0 || *s.rbegin() < 1000));
+  }
+
+  vector<uint64_t> v;
+  sample_without_replacement(5, 10, back_inserter(v), r);
+  CHECK(v.size() == 5);
+
+  // Each of 10 integers is selected with probability 3/10.
+  vector<int> hits(10);
+  for (int t = 0; t < 10000; t++) {
+    uint64_t w[3];
+    sample_without_replacement(10, 3, w, r);
+    for (uint64_t x : w) {
+      hits[x]++;
+    }
+  }
+  for (int h : hits) {
+    CHECK(abs(h - 3000) < 250);
+  }
+}
+
+TEST_CASE("sample_without_replacement (reservoir)") {
+  tinymt32 r(42);
+  vector<int> pop(1000);
+  iota(pop.begin(), pop.end(), 0);
+
+  vector<int> out(10);
+  auto end = sample_without_replacement(pop.begin(), pop.end(), out.begin(),
+                                        out.size(), r);
+  CHECK(end == out.end());
+  CHECK(set<int>(out.begin(), out.end()).size() == 10);
+
+  end = sample_without_replacement(pop.begin(), pop.begin() + 4, out.begin(),
+                                   out.size(), r);
+  CHECK(end == out.begin() + 4);
+
+  vector<int> hits(10);
+  for (int t = 0; t < 10000; t++) {
+    int w[3];
+    sample_without_replacement(pop.begin(), pop.begin() + 10, w, 3, r);
+    for (int x : w) {
+      hits[static_cast<size_t>(x)]++;
+    }
+  }
+  for (int h : hits) {
+    CHECK(abs(h - 3000) < 250);
+  }
+}
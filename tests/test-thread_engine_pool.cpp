@@ -0,0 +1,112 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest/doctest.h>
+#include <tinymt/thread_engine_pool.h>
+
+#include <cstdint>
+#include <random>
+#include <set>
+#include <thread>
+#include <vector>
+
+using namespace std;
+using namespace tinymt;
+
+namespace {
+
+bool is_aligned(const void* p) {
+  return reinterpret_cast<uintptr_t>(p) % detail::cache_line_size == 0;
+}
+
+}  // namespace
+
+TEST_CASE("seed") {
+  thread_engine_pool<tinymt32> pool(5, 100);
+  CHECK(pool.size() == 5);
+  for (size_t i = 0; i < pool.size(); i++) {
+    tinymt32 r(static_cast<tinymt32::result_type>(100 + i));
+    CHECK(pool[i] == r);
+    CHECK(is_aligned(&pool[i]));
+  }
+  for (size_t i = 1; i < pool.size(); i++) {
+    CHECK(reinterpret_cast<uintptr_t>(&pool[i]) -
+              reinterpret_cast<uintptr_t>(&pool[i - 1]) >=
+          detail::cache_line_size);
+  }
+
+  // Also works with other engines.
+  thread_engine_pool<mt19937> pool2(3, 7);
+  CHECK(pool2[2] == mt19937(9));
+  CHECK(is_aligned(&pool2[1]));
+}
+
+TEST_CASE("dc") {
+  vector<tinymt32_dc::param_type> params = {
+      {0x8f7011eeU, 0xfc78ff1fU, 0x3793fdffU},
+      {0xda251b45U, 0xfed0ffb5U, 0x9b5cf7ffU},
+      {0xf20d1e43U, 0xff90ffe5U, 0xdd372f7fU}};
+  thread_engine_pool<tinymt32_dc> pool(params, 42);
+  CHECK(pool.size() == 3);
+  for (size_t i = 0; i < pool.size(); i++) {
+    CHECK(pool[i] == tinymt32_dc(params[i], 42));
+    CHECK(is_aligned(&pool[i]));
+  }
+}
+
+TEST_CASE("local") {
+  const size_t n = 4;
+  thread_engine_pool<tinymt32> pool(n, 1);
+
+  // The same engine for the same thread.
+  tinymt32& r = pool.local();
+  CHECK(&pool.local() == &r);
+  CHECK(pool.local_ordinal() == 0);
+
+  // Another pool assigns the ordinals independently.
+  thread_engine_pool<tinymt32> pool2(n, 1);
+  CHECK(&pool2.local() == &pool2[0]);
+  CHECK(&pool.local() == &r);
+
+  vector<size_t> ordinals(n - 1);
+  vector<uint_fast32_t> values(n - 1);
+  vector<thread> threads;
+  for (size_t t = 0; t < n - 1; t++) {
+    threads.emplace_back([&pool, &ordinals, &values, t]() {
+      ordinals[t] = pool.local_ordinal();
+      tinymt32& e = pool.local();
+      for (int i = 0; i < 10000; i++) {
+        e();
+      }
+      values[t] = pool.local()();
+    });
+  }
+  for (auto& th : threads) {
+    th.join();
+  }
+
+  set<size_t> seen(ordinals.begin(), ordinals.end());
+  CHECK(seen.size() == n - 1);
+  CHECK(seen.count(0) == 0);
+  for (size_t t = 0; t < n - 1; t++) {
+    tinymt32 e(static_cast<tinymt32::result_type>(1 + ordinals[t]));
+    e.discard(10000);
+    CHECK(values[t] == e());
+  }
+
+  // No more free engines.
+  thread th([&pool]() {
+    CHECK_THROWS_AS(pool.local(), out_of_range);
+  });
+  th.join();
+}
+
+TEST_CASE("many pools") {
+  // A pool per job, which removes the entries of the destroyed pools, while
+  // another pool stays.
+  thread_engine_pool<tinymt32> pool(2, 1);
+  tinymt32& r = pool.local();
+  for (int i = 0; i < 1000; i++) {
+    thread_engine_pool<tinymt32> job(1, 1);
+    CHECK(&job.local() == &job[0]);
+    CHECK(&pool.local() == &r);
+  }
+}
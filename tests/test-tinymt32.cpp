@@ -2,9 +2,20 @@
 #include <doctest/doctest.h>
 #include <tinymt/tinymt.h>
 
+#include <vector>
+
 using namespace std;
 using namespace tinymt;
 
+// Packed in 32-bit words even if uint_fast32_t is wider.
+static_assert(sizeof(tinymt32) == 16, "");
+
+// Exact comparison of floating-point numbers.
+template <class T>
+bool same(T x, T y) {
+  return memcmp(&x, &y, sizeof(T)) == 0;
+}
+
 TEST_CASE("range") {
   std::size_t w = tinymt32::word_size;
   CHECK(w == 32);
@@ -24,6 +35,22 @@ TEST_CASE("seed") {
   CHECK(r() == 392941632);
 }
 
+TEST_CASE("seed_many") {
+  // Not a multiple of the block size.
+  const size_t n = 37;
+  vector<tinymt32::result_type> seeds(n);
+  for (size_t i = 0; i < n; i++) {
+    seeds[i] = static_cast<tinymt32::result_type>(i * 0x9e3779b9U);
+  }
+  vector<tinymt32> r(n);
+  tinymt32::seed_many(r.data(), seeds.data(), n);
+  for (size_t i = 0; i < n; i++) {
+    tinymt32 r2(seeds[i]);
+    CHECK_MESSAGE(r[i] == r2, "i = " << i);
+    CHECK_MESSAGE(r[i]() == r2(), "i = " << i);
+  }
+}
+
 TEST_CASE("discard") {
   tinymt32 r1;
   tinymt32 r2;
@@ -37,6 +64,187 @@ TEST_CASE("discard") {
   CHECK(r1() == r2());
 }
 
+TEST_CASE("discard (jump)") {
+  const unsigned long long zs[] = {1023, 1024, 1025, 12345};  // NOLINT
+
+  for (auto z : zs) {
+    tinymt32 r1;
+    tinymt32 r2;
+
+    r1();
+
+    for (unsigned long long i = 0; i < z; i++) {  // NOLINT
+      r1();
+    }
+
+    r2();
+    r2.discard(z);
+
+    CHECK_MESSAGE(r1 == r2, "z = " << z);
+    CHECK_MESSAGE(r1() == r2(), "z = " << z);
+  }
+
+  tinymt32 r1;
+  tinymt32 r2;
+
+  r1.discard(1000000000000ULL);
+  r1.discard(23456789ULL);
+  r2.discard(1000023456789ULL);
+
+  CHECK(r1 == r2);
+  CHECK(r1() == r2());
+}
+
+TEST_CASE("advance_pow2") {
+  for (size_t e = 0; e < 64; e += 7) {
+    tinymt32 r1;
+    tinymt32 r2;
+    r1.discard(1ULL << e);
+    r2.advance_pow2(e);
+    CHECK_MESSAGE(r1 == r2, "e = " << e);
+  }
+
+  // The period is 2^127 - 1.
+  tinymt32 r1;
+  tinymt32 r2;
+  r1.discard(1);
+  r2.advance_pow2(127);
+  CHECK(r1 == r2);
+  r2 = tinymt32();
+  r2.advance_pow2(126);
+  r2.advance_pow2(126);
+  CHECK(r1 == r2);
+}
+
+TEST_CASE("split") {
+  tinymt32 r;
+  r.discard(10);
+  CHECK(r.split(0, 5) == r);
+
+  // 5 substreams of 2^124 numbers.
+  tinymt32 r1 = r;
+  r1.advance_pow2(124);
+  r1.advance_pow2(124);
+  r1.advance_pow2(124);
+  CHECK(r.split(3, 5) == r1);
+  CHECK(r.split(3, 5)() == r1());
+
+  tinymt32 r2 = r;
+  // 2^63 substreams of 2^63 numbers.
+  for (int i = 0; i < 3; i++) {
+    r2.discard(1ULL << 63);
+  }
+  CHECK(r.split(3, 1ULL << 63) == r2);
+}
+
+TEST_CASE("step_back") {
+  // Skip the initial state, whose unused bit may not be restored.
+  tinymt32 r1;
+  r1();
+  const tinymt32 r2 = r1;
+
+  for (int i = 0; i < 100; i++) {
+    const auto x = r1();
+    r1.step_back();
+    CHECK(r1() == x);
+  }
+  for (int i = 0; i < 100; i++) {
+    r1.step_back();
+  }
+  CHECK(r1 == r2);
+}
+
+TEST_CASE("rewind") {
+  const unsigned long long zs[] = {0, 1, 1023, 1024, 12345,  // NOLINT
+                                    1000000000000ULL};
+
+  for (auto z : zs) {
+    tinymt32 r1;
+    r1();
+    tinymt32 r2 = r1;
+
+    r2.discard(z);
+    r2.rewind(z);
+    CHECK_MESSAGE(r1 == r2, "z = " << z);
+
+    r2.rewind(z);
+    r2.discard(z);
+    CHECK_MESSAGE(r1 == r2, "z = " << z);
+  }
+
+  // Jump and steps.
+  tinymt32 r1;
+  r1.discard(10);
+  tinymt32 r2 = r1;
+  r1.rewind(2000);
+  for (int i = 0; i < 2000; i++) {
+    r2.step_back();
+  }
+  CHECK(r1 == r2);
+}
+
+TEST_CASE("generate") {
+  tinymt32 r1;
+  tinymt32 r2;
+  tinymt32 r3;
+
+  tinymt32::result_type x2[100];
+  uint32_t x3[100];
+
+  r2.generate(begin(x2), end(x2));
+  r3.fill(x3, 100);
+
+  for (int i = 0; i < 100; i++) {
+    tinymt32::result_type x1 = r1();
+    CHECK_MESSAGE(x2[i] == x1, "x2[" << i << "]");
+    CHECK_MESSAGE(x3[i] == x1, "x3[" << i << "]");
+  }
+
+  CHECK(r1 == r2);
+  CHECK(r1 == r3);
+}
+
+TEST_CASE("float") {
+  const float two24 = 16777216.0f;
+  const float two23 = 8388608.0f;
+  const double two32 = 4294967296.0;
+
+  tinymt32 r1;
+  tinymt32 r2;
+
+  for (int i = 0; i < 100; i++) {
+    float x = r1.generate_float();
+    CHECK(same(x, static_cast<float>(r2() >> 8) / two24));
+    CHECK(x >= 0.0f);
+    CHECK(x < 1.0f);
+
+    x = r1.generate_float12();
+    CHECK(same(x, 1.0f + static_cast<float>(r2() >> 9) / two23));
+    CHECK(x >= 1.0f);
+    CHECK(x < 2.0f);
+
+    x = r1.generate_float01();
+    CHECK(same(x, static_cast<float>(r2() >> 9) / two23));
+    CHECK(x >= 0.0f);
+    CHECK(x < 1.0f);
+
+    x = r1.generate_floatOC();
+    CHECK(same(x, 1.0f - static_cast<float>(r2() >> 9) / two23));
+    CHECK(x > 0.0f);
+    CHECK(x <= 1.0f);
+
+    x = r1.generate_floatOO();
+    CHECK(same(x, static_cast<float>((r2() >> 9) | 1) / two23));
+    CHECK(x > 0.0f);
+    CHECK(x < 1.0f);
+
+    double y = r1.generate_32double();
+    CHECK(same(y, static_cast<double>(r2()) / two32));
+    CHECK(y >= 0.0);
+    CHECK(y < 1.0);
+  }
+}
+
 TEST_CASE("equals") {
   tinymt32 r1;
   tinymt32 r2;
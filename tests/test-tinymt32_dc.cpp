@@ -2,9 +2,14 @@
 #include <doctest/doctest.h>
 #include <tinymt/tinymt.h>
 
+#include <vector>
+
 using namespace std;
 using namespace tinymt;
 
+// Packed in 32-bit words even if uint_fast32_t is wider.
+static_assert(sizeof(tinymt32_dc) == 28, "");
+
 // Parameter sets taken from https://github.com/jj1bdx/tinymtdc-longbatch/.
 
 // tinymt32dc.0.1048576.txt.1, i.e., RFC 8682
@@ -35,6 +40,25 @@ TEST_CASE("seed") {
   CHECK(r() == 2165469340);
 }
 
+TEST_CASE("seed_many") {
+  // Not a multiple of the block size.
+  const size_t n = 37;
+  const tinymt32_dc::param_type ids[] = {id0, id1, id2};
+  vector<tinymt32_dc::param_type> params(n);
+  vector<tinymt32_dc::result_type> seeds(n);
+  for (size_t i = 0; i < n; i++) {
+    params[i] = ids[i % 3];
+    seeds[i] = static_cast<tinymt32_dc::result_type>(i * 0x9e3779b9U);
+  }
+  vector<tinymt32_dc> r(n, tinymt32_dc(id0));
+  tinymt32_dc::seed_many(r.data(), params.data(), seeds.data(), n);
+  for (size_t i = 0; i < n; i++) {
+    tinymt32_dc r2(params[i], seeds[i]);
+    CHECK_MESSAGE(r[i] == r2, "i = " << i);
+    CHECK_MESSAGE(r[i]() == r2(), "i = " << i);
+  }
+}
+
 TEST_CASE("discard") {
   tinymt32_dc r1(id1);
   tinymt32_dc r2(id1);
@@ -48,6 +72,163 @@ TEST_CASE("discard") {
   CHECK(r1() == r2());
 }
 
+TEST_CASE("discard (jump)") {
+  const unsigned long long zs[] = {1023, 1024, 1025, 12345};  // NOLINT
+
+  for (auto z : zs) {
+    tinymt32_dc r1(id1);
+    tinymt32_dc r2(id1);
+
+    r1();
+
+    for (unsigned long long i = 0; i < z; i++) {  // NOLINT
+      r1();
+    }
+
+    r2();
+    r2.discard(z);
+
+    CHECK_MESSAGE(r1 == r2, "z = " << z);
+    CHECK_MESSAGE(r1() == r2(), "z = " << z);
+  }
+
+  tinymt32_dc r1(id1);
+  tinymt32_dc r2(id1);
+
+  r1.discard(1000000000000ULL);
+  r1.discard(23456789ULL);
+  r2.discard(1000023456789ULL);
+
+  CHECK(r1 == r2);
+  CHECK(r1() == r2());
+}
+
+TEST_CASE("advance_pow2") {
+  for (size_t e = 0; e < 64; e += 7) {
+    tinymt32_dc r1(id1);
+    tinymt32_dc r2(id1);
+    r1.discard(1ULL << e);
+    r2.advance_pow2(e);
+    CHECK_MESSAGE(r1 == r2, "e = " << e);
+  }
+
+  // The period is 2^127 - 1.
+  tinymt32_dc r1(id1);
+  tinymt32_dc r2(id1);
+  r1.discard(1);
+  r2.advance_pow2(127);
+  CHECK(r1 == r2);
+  r2 = tinymt32_dc(id1);
+  r2.advance_pow2(126);
+  r2.advance_pow2(126);
+  CHECK(r1 == r2);
+}
+
+TEST_CASE("split") {
+  tinymt32_dc r(id1);
+  r.discard(10);
+  CHECK(r.split(0, 5) == r);
+
+  // 5 substreams of 2^124 numbers.
+  tinymt32_dc r1 = r;
+  r1.advance_pow2(124);
+  r1.advance_pow2(124);
+  r1.advance_pow2(124);
+  CHECK(r.split(3, 5) == r1);
+  CHECK(r.split(3, 5)() == r1());
+
+  tinymt32_dc r2 = r;
+  // 2^63 substreams of 2^63 numbers.
+  for (int i = 0; i < 3; i++) {
+    r2.discard(1ULL << 63);
+  }
+  CHECK(r.split(3, 1ULL << 63) == r2);
+}
+
+TEST_CASE("split (cache)") {
+  // More parameter sets than the cache entries, used repeatedly.
+  const tinymt32_dc::param_type ids[] = {id0, id1, id2};
+  for (int i = 0; i < 3; i++) {
+    for (const auto& id : ids) {
+      tinymt32_dc r(id);
+      tinymt32_dc r1 = r.split(1, 1ULL << 63);
+      r.discard(1ULL << 63);
+      CHECK(r == r1);
+    }
+  }
+
+  tinymt32_dc bad({0, 0, 0});
+  CHECK_THROWS_AS(bad.advance_pow2(64), std::domain_error);
+  CHECK_THROWS_AS(bad.split(1, 2), std::domain_error);
+}
+
+TEST_CASE("step_back") {
+  // Skip the initial state, whose unused bit may not be restored.
+  tinymt32_dc r1(id1);
+  r1();
+  const tinymt32_dc r2 = r1;
+
+  for (int i = 0; i < 100; i++) {
+    const auto x = r1();
+    r1.step_back();
+    CHECK(r1() == x);
+  }
+  for (int i = 0; i < 100; i++) {
+    r1.step_back();
+  }
+  CHECK(r1 == r2);
+}
+
+TEST_CASE("rewind") {
+  const unsigned long long zs[] = {0, 1, 1023, 1024, 12345,  // NOLINT
+                                    1000000000000ULL};
+
+  for (auto z : zs) {
+    tinymt32_dc r1(id2, 42);
+    r1();
+    tinymt32_dc r2 = r1;
+
+    r2.discard(z);
+    r2.rewind(z);
+    CHECK_MESSAGE(r1 == r2, "z = " << z);
+
+    r2.rewind(z);
+    r2.discard(z);
+    CHECK_MESSAGE(r1 == r2, "z = " << z);
+  }
+
+  // Jump and steps.
+  tinymt32_dc r1(id1);
+  r1.discard(10);
+  tinymt32_dc r2 = r1;
+  r1.rewind(2000);
+  for (int i = 0; i < 2000; i++) {
+    r2.step_back();
+  }
+  CHECK(r1 == r2);
+}
+
+TEST_CASE("generate") {
+  tinymt32_dc r1(id1);
+  tinymt32_dc r2(id1);
+  tinymt32_dc r3(id1);
+
+  tinymt32_dc::result_type x2[100];
+  uint32_t x3[100];
+
+  r2.generate(begin(x2), end(x2));
+  r3.fill(x3, 100);
+
+  for (int i = 0; i < 100; i++) {
+    tinymt32_dc::result_type x1 = r1();
+    CHECK_MESSAGE(x2[i] == x1, "x2[" << i << "]");
+    CHECK_MESSAGE(x3[i] == x1, "x3[" << i << "]");
+  }
+
+  CHECK(r1 == r2);
+  CHECK(r1 == r3);
+}
+
 TEST_CASE("equals1") {
   tinymt32_dc r1(id1);
   tinymt32_dc r2(id1);
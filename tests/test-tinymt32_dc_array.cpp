@@ -0,0 +1,174 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest/doctest.h>
+#include <tinymt/tinymt.h>
+
+using namespace std;
+using namespace tinymt;
+
+// Parameter sets taken from https://github.com/jj1bdx/tinymtdc-longbatch/.
+
+// tinymt32dc.0.1048576.txt.1, i.e., RFC 8682
+constexpr tinymt32_dc::param_type id0 = {0x8f7011eeU, 0xfc78ff1fU, 0x3793fdffU};
+
+// tinymt32dc.1.1048576.txt:1
+constexpr tinymt32_dc::param_type id1 = {0xda251b45U, 0xfed0ffb5U, 0x9b5cf7ffU};
+
+// tinymt32dc.2.1048576.txt:1
+constexpr tinymt32_dc::param_type id2 = {0xf20d1e43U, 0xff90ffe5U, 0xdd372f7fU};
+
+using array_type = tinymt32_dc_array<8>;
+
+const array<array_type::param_type, 8> lane_params = {
+    {id0, id1, id2, id0, id1, id2, id0, id1}};
+
+const array<array_type::result_type, 8> lane_seeds = {{1, 1, 1, 2, 3, 4, 5, 6}};
+
+TEST_CASE("range") {
+  std::size_t w = array_type::word_size;
+  CHECK(w == 32);
+
+  std::size_t n = array_type::lanes;
+  CHECK(n == 8);
+
+  CHECK(array_type::min() == 0);
+  CHECK(array_type::max() == 0xffffffffU);
+}
+
+TEST_CASE("lanes") {
+  array_type r(lane_params, lane_seeds);
+
+  vector<tinymt32_dc> e;
+  for (std::size_t i = 0; i < 8; i++) {
+    e.emplace_back(lane_params[i], lane_seeds[i]);
+  }
+
+  for (int k = 0; k < 100; k++) {
+    auto x = r();
+    for (std::size_t i = 0; i < 8; i++) {
+      CHECK_MESSAGE(x[i] == e[i](), "k = " << k << ", i = " << i);
+    }
+  }
+}
+
+TEST_CASE("fill") {
+  array_type r1(lane_params, lane_seeds);
+  array_type r2(lane_params, lane_seeds);
+
+  array_type::result_type x1[8 * 10];
+  uint32_t x2[8 * 10 - 3];
+
+  for (std::size_t k = 0; k < 10; k++) {
+    auto x = r1();
+    copy(x.begin(), x.end(), x1 + 8 * k);
+  }
+
+  r2.fill(x2, 8 * 10 - 3);
+
+  for (std::size_t k = 0; k < 8 * 10 - 3; k++) {
+    CHECK_MESSAGE(x1[k] == x2[k], "k = " << k);
+  }
+
+  CHECK(r1 == r2);
+}
+
+TEST_CASE("seed") {
+  array_type r(id1);
+  r.seed(3, id2, 42);
+
+  tinymt32_dc e1(id1);
+  tinymt32_dc e2(id2, 42);
+
+  for (int k = 0; k < 10; k++) {
+    auto x = r();
+    CHECK(x[0] == e1());
+    CHECK(x[3] == e2());
+  }
+}
+
+TEST_CASE("discard") {
+  array_type r1(lane_params, lane_seeds);
+  array_type r2(lane_params, lane_seeds);
+
+  for (int i = 0; i < 2000; i++) {
+    r1();
+  }
+
+  r2.discard(2000);
+
+  CHECK(r1 == r2);
+  CHECK(r1() == r2());
+}
+
+TEST_CASE("equals") {
+  array_type r1(lane_params, lane_seeds);
+  array_type r2(lane_params, lane_seeds);
+
+  CHECK(r1 == r2);
+
+  r1();
+
+  CHECK(r1 != r2);
+
+  r2();
+
+  CHECK(r1 == r2);
+
+  r2.seed(7, id2);
+
+  CHECK(r1 != r2);
+}
+
+template <std::size_t Lanes>
+void check_kernel(detail::simd_level level) {
+  using kernel = detail::tinymt32_lanes<Lanes>;
+  using impl = detail::tinymt_engine_impl<uint_fast32_t, 32, 0, 0, 0, true>;
+
+  typename kernel::status_words st;
+  typename kernel::lane_words mat1;
+  typename kernel::lane_words mat2;
+  typename kernel::lane_words tmat;
+  vector<tinymt32_dc> e;
+  for (std::size_t i = 0; i < Lanes; i++) {
+    const auto& param = lane_params[i % 8];
+    const uint_fast32_t seed = 100 + i;
+    impl::status_type t;
+    t.mat1 = param.mat1;
+    t.mat2 = param.mat2;
+    t.tmat = param.tmat;
+    impl::init(t, seed);
+    for (std::size_t j = 0; j < 4; j++) {
+      st[j][i] = static_cast<uint32_t>(t.status[j]);
+    }
+    mat1[i] = param.mat1;
+    mat2[i] = param.mat2;
+    tmat[i] = param.tmat;
+    e.emplace_back(param, seed);
+  }
+
+  const std::size_t steps = 100;
+  vector<uint32_t> x(Lanes * steps);
+  kernel::template select_generate<uint32_t>(level)(st, mat1, mat2, tmat,
+                                                     x.data(), steps);
+  for (std::size_t k = 0; k < steps; k++) {
+    for (std::size_t i = 0; i < Lanes; i++) {
+      CHECK_MESSAGE(x[k * Lanes + i] == e[i](), "k = " << k << ", i = " << i);
+    }
+  }
+}
+
+TEST_CASE("kernels") {
+  const detail::simd_level levels[] = {detail::simd_level::portable,
+                                       detail::simd_level::avx2,
+                                       detail::simd_level::avx512};
+  for (const auto level : levels) {
+    if (static_cast<int>(level) >
+        static_cast<int>(detail::detected_simd_level())) {
+      MESSAGE("level " << static_cast<int>(level)
+                       << " is not available");
+      continue;
+    }
+    check_kernel<8>(level);
+    check_kernel<16>(level);
+    check_kernel<5>(level);
+  }
+}
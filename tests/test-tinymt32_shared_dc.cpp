@@ -0,0 +1,66 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest/doctest.h>
+#include <tinymt/tinymt.h>
+
+#include <vector>
+
+using namespace std;
+using namespace tinymt;
+
+namespace {
+
+// Parameter sets taken from https://github.com/jj1bdx/tinymtdc-longbatch/.
+struct params {
+  static const tinymt32_dc::param_type& get(size_t i) {
+    static const tinymt32_dc::param_type table[] = {
+        {0x8f7011eeU, 0xfc78ff1fU, 0x3793fdffU},
+        {0xda251b45U, 0xfed0ffb5U, 0x9b5cf7ffU},
+        {0xf20d1e43U, 0xff90ffe5U, 0xdd372f7fU},
+    };
+    return table[i];
+  }
+};
+
+using engine = tinymt32_shared_dc<params>;
+
+}  // namespace
+
+// Four words of the state and the index.
+static_assert(sizeof(engine) == 20, "");
+
+TEST_CASE("same as tinymt32_dc") {
+  for (size_t i = 0; i < 3; i++) {
+    engine r1(i, 42);
+    tinymt32_dc r2(params::get(i), 42);
+    CHECK(r1.index() == i);
+    CHECK(r1.param().mat1 == params::get(i).mat1);
+    CHECK(r1.param().tmat == params::get(i).tmat);
+    for (int k = 0; k < 1000; k++) {
+      CHECK(r1() == r2());
+    }
+
+    r1.discard(12345);
+    r2.discard(12345);
+    vector<uint_fast32_t> v1(100);
+    vector<uint_fast32_t> v2(100);
+    r1.generate(v1.begin(), v1.end());
+    r2.generate(v2.begin(), v2.end());
+    CHECK(v1 == v2);
+
+    r1.seed(7);
+    r2.seed(7);
+    CHECK(r1() == r2());
+  }
+}
+
+TEST_CASE("equals") {
+  engine r1(0, 42);
+  engine r2(0, 42);
+  engine r3(1, 42);
+  CHECK(r1 == r2);
+  CHECK(r1 != r3);
+  r2();
+  CHECK(r1 != r2);
+  r1();
+  CHECK(r1 == r2);
+}
@@ -0,0 +1,281 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest/doctest.h>
+#include <tinymt/tinymt.h>
+
+#include <vector>
+
+using namespace std;
+using namespace tinymt;
+
+// Exact comparison of floating-point numbers.
+template <class T>
+bool same(T x, T y) {
+  return memcmp(&x, &y, sizeof(T)) == 0;
+}
+
+TEST_CASE("reference") {
+  // Taken from check64.out.txt of the reference implementation.
+  const tinymt64::result_type expected[] = {
+      15503804787016557143U, 17280942441431881838U, 2177846447079362065U,
+      10087979609567186558U, 8925138365609588954U,  13030236470185662861U,
+      4821755207395923002U,  11414418928600017220U, 18168456707151075513U,
+      1749899882787913913U,
+  };
+
+  tinymt64 mt(1);
+
+  for (int i = 0; i < 10; i++) {
+    CHECK_MESSAGE(mt() == expected[i], "x[" << i << "]");
+  }
+}
+
+TEST_CASE("range") {
+  std::size_t w = tinymt64::word_size;
+  CHECK(w == 64);
+
+  CHECK(tinymt64::min() == 0);
+  CHECK(tinymt64::max() == 0xffffffffffffffffU);
+}
+
+TEST_CASE("seed") {
+  tinymt64 r;
+  r.seed(42);
+
+  tinymt64 r2(42);
+
+  for (int i = 1; i <= 9; i++) {
+    r();
+    r2();
+  }
+
+  CHECK(r() == r2());
+}
+
+TEST_CASE("seed_many") {
+  // Not a multiple of the block size.
+  const size_t n = 37;
+  vector<tinymt64::result_type> seeds(n);
+  for (size_t i = 0; i < n; i++) {
+    seeds[i] = static_cast<tinymt64::result_type>(i * 0x9e3779b97f4a7c15U);
+  }
+  vector<tinymt64> r(n);
+  tinymt64::seed_many(r.data(), seeds.data(), n);
+  for (size_t i = 0; i < n; i++) {
+    tinymt64 r2(seeds[i]);
+    CHECK_MESSAGE(r[i] == r2, "i = " << i);
+    CHECK_MESSAGE(r[i]() == r2(), "i = " << i);
+  }
+}
+
+TEST_CASE("discard") {
+  tinymt64 r1;
+  tinymt64 r2;
+
+  for (int i = 0; i < 10; i++) {
+    r1();
+  }
+
+  r2.discard(10);
+
+  CHECK(r1() == r2());
+}
+
+TEST_CASE("discard (jump)") {
+  const unsigned long long zs[] = {1023, 1024, 1025, 12345};  // NOLINT
+
+  for (auto z : zs) {
+    tinymt64 r1;
+    tinymt64 r2;
+
+    r1();
+
+    for (unsigned long long i = 0; i < z; i++) {  // NOLINT
+      r1();
+    }
+
+    r2();
+    r2.discard(z);
+
+    CHECK_MESSAGE(r1 == r2, "z = " << z);
+    CHECK_MESSAGE(r1() == r2(), "z = " << z);
+  }
+
+  tinymt64 r1;
+  tinymt64 r2;
+
+  r1.discard(1000000000000ULL);
+  r1.discard(23456789ULL);
+  r2.discard(1000023456789ULL);
+
+  CHECK(r1 == r2);
+  CHECK(r1() == r2());
+}
+
+TEST_CASE("advance_pow2") {
+  for (size_t e = 0; e < 64; e += 7) {
+    tinymt64 r1;
+    tinymt64 r2;
+    r1.discard(1ULL << e);
+    r2.advance_pow2(e);
+    CHECK_MESSAGE(r1 == r2, "e = " << e);
+  }
+
+  // The period is 2^127 - 1.
+  tinymt64 r1;
+  tinymt64 r2;
+  r1.discard(1);
+  r2.advance_pow2(127);
+  CHECK(r1 == r2);
+  r2 = tinymt64();
+  r2.advance_pow2(126);
+  r2.advance_pow2(126);
+  CHECK(r1 == r2);
+}
+
+TEST_CASE("split") {
+  tinymt64 r;
+  r.discard(10);
+  CHECK(r.split(0, 5) == r);
+
+  // 5 substreams of 2^124 numbers.
+  tinymt64 r1 = r;
+  r1.advance_pow2(124);
+  r1.advance_pow2(124);
+  r1.advance_pow2(124);
+  CHECK(r.split(3, 5) == r1);
+  CHECK(r.split(3, 5)() == r1());
+
+  tinymt64 r2 = r;
+  // 2^63 substreams of 2^63 numbers.
+  for (int i = 0; i < 3; i++) {
+    r2.discard(1ULL << 63);
+  }
+  CHECK(r.split(3, 1ULL << 63) == r2);
+}
+
+TEST_CASE("step_back") {
+  // Skip the initial state, whose unused bit may not be restored.
+  tinymt64 r1;
+  r1();
+  const tinymt64 r2 = r1;
+
+  for (int i = 0; i < 100; i++) {
+    const auto x = r1();
+    r1.step_back();
+    CHECK(r1() == x);
+  }
+  for (int i = 0; i < 100; i++) {
+    r1.step_back();
+  }
+  CHECK(r1 == r2);
+}
+
+TEST_CASE("rewind") {
+  const unsigned long long zs[] = {0, 1, 1023, 1024, 12345,  // NOLINT
+                                    1000000000000ULL};
+
+  for (auto z : zs) {
+    tinymt64 r1;
+    r1();
+    tinymt64 r2 = r1;
+
+    r2.discard(z);
+    r2.rewind(z);
+    CHECK_MESSAGE(r1 == r2, "z = " << z);
+
+    r2.rewind(z);
+    r2.discard(z);
+    CHECK_MESSAGE(r1 == r2, "z = " << z);
+  }
+
+  // Jump and steps.
+  tinymt64 r1;
+  r1.discard(10);
+  tinymt64 r2 = r1;
+  r1.rewind(2000);
+  for (int i = 0; i < 2000; i++) {
+    r2.step_back();
+  }
+  CHECK(r1 == r2);
+}
+
+TEST_CASE("generate") {
+  tinymt64 r1;
+  tinymt64 r2;
+
+  uint_least64_t x2[100];
+
+  r2.fill(x2, 100);
+
+  for (int i = 0; i < 100; i++) {
+    CHECK_MESSAGE(x2[i] == r1(), "x2[" << i << "]");
+  }
+
+  CHECK(r1 == r2);
+}
+
+TEST_CASE("double") {
+  const double two53 = 9007199254740992.0;
+  const double two52 = 4503599627370496.0;
+
+  tinymt64 r1;
+  tinymt64 r2;
+
+  for (int i = 0; i < 100; i++) {
+    double x = r1.generate_double();
+    CHECK(same(x, static_cast<double>(r2() >> 11) / two53));
+    CHECK(x >= 0.0);
+    CHECK(x < 1.0);
+
+    x = r1.generate_double12();
+    CHECK(same(x, 1.0 + static_cast<double>(r2() >> 12) / two52));
+    CHECK(x >= 1.0);
+    CHECK(x < 2.0);
+
+    x = r1.generate_double01();
+    CHECK(same(x, static_cast<double>(r2() >> 12) / two52));
+    CHECK(x >= 0.0);
+    CHECK(x < 1.0);
+
+    x = r1.generate_doubleOC();
+    CHECK(same(x, 1.0 - static_cast<double>(r2() >> 12) / two52));
+    CHECK(x > 0.0);
+    CHECK(x <= 1.0);
+
+    x = r1.generate_doubleOO();
+    CHECK(same(x, static_cast<double>((r2() >> 12) | 1) / two52));
+    CHECK(x > 0.0);
+    CHECK(x < 1.0);
+  }
+}
+
+TEST_CASE("equals") {
+  tinymt64 r1;
+  tinymt64 r2;
+
+  CHECK(r1 == r2);
+
+  r1();
+
+  CHECK(r1 != r2);
+
+  r2();
+
+  CHECK(r1 == r2);
+}
+
+TEST_CASE("serialize") {
+  stringstream buf;
+
+  tinymt64 r1;
+  r1();
+  r1();
+  buf << r1;
+  tinymt64::result_type x1 = r1();
+
+  tinymt64 r2;
+  buf >> r2;
+  tinymt64::result_type x2 = r2();
+
+  CHECK(x1 == x2);
+}
@@ -0,0 +1,136 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest/doctest.h>
+#include <tinymt/tinymt.h>
+
+#include <vector>
+
+using namespace std;
+using namespace tinymt;
+
+// The default parameter set of TinyMT64.
+constexpr tinymt64_dc::param_type id0 = {0xfa051f40U, 0xffd0fff4U,
+                                         0x58d02ffeffbfffbcU};
+
+// The same state transition with a different tempering parameter.
+constexpr tinymt64_dc::param_type id1 = {0xfa051f40U, 0xffd0fff4U,
+                                         0x3793fdff8f7011eeU};
+
+TEST_CASE("range") {
+  std::size_t w = tinymt64_dc::word_size;
+  CHECK(w == 64);
+
+  CHECK(tinymt64_dc::min() == 0);
+  CHECK(tinymt64_dc::max() == 0xffffffffffffffffU);
+}
+
+TEST_CASE("default parameter set") {
+  tinymt64_dc r1(id0, 42);
+  tinymt64 r2(42);
+
+  for (int i = 0; i < 100; i++) {
+    CHECK_MESSAGE(r1() == r2(), "i = " << i);
+  }
+}
+
+TEST_CASE("seed_many") {
+  // Not a multiple of the block size.
+  const size_t n = 37;
+  const tinymt64_dc::param_type ids[] = {id0, id1};
+  vector<tinymt64_dc::param_type> params(n);
+  vector<tinymt64_dc::result_type> seeds(n);
+  for (size_t i = 0; i < n; i++) {
+    params[i] = ids[i % 2];
+    seeds[i] = static_cast<tinymt64_dc::result_type>(i * 0x9e3779b97f4a7c15U);
+  }
+  vector<tinymt64_dc> r(n, tinymt64_dc(id0));
+  tinymt64_dc::seed_many(r.data(), params.data(), seeds.data(), n);
+  for (size_t i = 0; i < n; i++) {
+    tinymt64_dc r2(params[i], seeds[i]);
+    CHECK_MESSAGE(r[i] == r2, "i = " << i);
+    CHECK_MESSAGE(r[i]() == r2(), "i = " << i);
+  }
+}
+
+TEST_CASE("discard (jump)") {
+  tinymt64_dc r1(id1);
+  tinymt64_dc r2(id1);
+
+  for (int i = 0; i < 5000; i++) {
+    r1();
+  }
+
+  r2.discard(5000);
+
+  CHECK(r1 == r2);
+  CHECK(r1() == r2());
+}
+
+TEST_CASE("step_back") {
+  // Skip the initial state, whose unused bit may not be restored.
+  tinymt64_dc r1(id1);
+  r1();
+  const tinymt64_dc r2 = r1;
+
+  for (int i = 0; i < 100; i++) {
+    const auto x = r1();
+    r1.step_back();
+    CHECK(r1() == x);
+  }
+  for (int i = 0; i < 100; i++) {
+    r1.step_back();
+  }
+  CHECK(r1 == r2);
+}
+
+TEST_CASE("rewind") {
+  const unsigned long long zs[] = {0, 1, 1023, 1024, 12345,  // NOLINT
+                                    1000000000000ULL};
+
+  for (auto z : zs) {
+    tinymt64_dc r1(id0, 42);
+    r1();
+    tinymt64_dc r2 = r1;
+
+    r2.discard(z);
+    r2.rewind(z);
+    CHECK_MESSAGE(r1 == r2, "z = " << z);
+
+    r2.rewind(z);
+    r2.discard(z);
+    CHECK_MESSAGE(r1 == r2, "z = " << z);
+  }
+
+  // Jump and steps.
+  tinymt64_dc r1(id1);
+  r1.discard(10);
+  tinymt64_dc r2 = r1;
+  r1.rewind(2000);
+  for (int i = 0; i < 2000; i++) {
+    r2.step_back();
+  }
+  CHECK(r1 == r2);
+}
+
+TEST_CASE("equals") {
+  tinymt64_dc r1(id0);
+  tinymt64_dc r2(id1);
+
+  CHECK(r1 != r2);
+}
+
+TEST_CASE("serialize") {
+  stringstream buf;
+
+  tinymt64_dc r1(id1);
+  r1();
+  r1();
+  buf << r1;
+  tinymt64_dc::result_type x1 = r1();
+
+  tinymt64_dc r2(id0);
+  buf >> r2;
+  tinymt64_dc::result_type x2 = r2();
+
+  CHECK(x1 == x2);
+  CHECK(r1 == r2);
+}
@@ -0,0 +1,138 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest/doctest.h>
+#include <tinymt/tinymt.h>
+
+#include <random>
+
+using namespace std;
+using namespace tinymt;
+
+TEST_CASE("lemire") {
+  tinymt32 r1;
+  tinymt32 r2;
+  uniform_int<uint32_t> dist(0, 999);
+
+  for (int i = 0; i < 1000; i++) {
+    uint32_t x = dist(r1);
+    // No rejection happens for words >= 2^32 mod 1000 = 296.
+    uint_least64_t m = static_cast<uint_least64_t>(r2()) * 1000;
+    while ((m & 0xffffffffU) < 296) {
+      m = static_cast<uint_least64_t>(r2()) * 1000;
+    }
+    CHECK(x == (m >> 32));
+  }
+
+  CHECK(r1 == r2);
+}
+
+TEST_CASE("range") {
+  tinymt32 r;
+
+  uniform_int<int> dist1(-3, 3);
+  int count[7] = {};
+  for (int i = 0; i < 7000; i++) {
+    int x = dist1(r);
+    REQUIRE(x >= -3);
+    REQUIRE(x <= 3);
+    count[x + 3]++;
+  }
+  for (int c : count) {
+    CHECK(c > 850);
+    CHECK(c < 1150);
+  }
+
+  uniform_int<int> dist2(5, 5);
+  CHECK(dist2(r) == 5);
+
+  uniform_int<int8_t> dist3;
+  for (int i = 0; i < 100; i++) {
+    int8_t x = dist3(r);
+    CHECK(x >= 0);
+  }
+
+  uniform_int<int64_t> dist4(numeric_limits<int64_t>::min(),
+                                          numeric_limits<int64_t>::max());
+  uniform_int<int64_t> dist5(-10000000000LL, 10000000000LL);
+  tinymt64 r64;
+  bool negative = false;
+  for (int i = 0; i < 100; i++) {
+    negative = negative || dist4(r) < 0;
+    int64_t x = dist5(r);
+    CHECK(x >= -10000000000LL);
+    CHECK(x <= 10000000000LL);
+    x = dist5(r64);
+    CHECK(x >= -10000000000LL);
+    CHECK(x <= 10000000000LL);
+  }
+  CHECK(negative);
+
+  uniform_int<uint32_t> dist6;
+  tinymt32 r2 = r;
+  CHECK(dist6(r) == r2());
+}
+
+TEST_CASE("generate") {
+  uniform_int<int> dist(10, 20);
+
+  tinymt32 r1;
+  tinymt32 r2;
+  int x[1000];
+  dist.generate(begin(x), end(x), r2);
+  for (int i = 0; i < 1000; i++) {
+    CHECK_MESSAGE(x[i] == dist(r1), "x[" << i << "]");
+  }
+  CHECK(r1 == r2);
+
+  tinymt64 r3;
+  tinymt64 r4;
+  dist.generate(begin(x), end(x), r4);
+  for (int i = 0; i < 1000; i++) {
+    CHECK_MESSAGE(x[i] == dist(r3), "x[" << i << "]");
+  }
+  CHECK(r3 == r4);
+
+  mt19937 r5;
+  mt19937 r6;
+  dist.generate(begin(x), end(x), r6);
+  for (int i = 0; i < 1000; i++) {
+    CHECK_MESSAGE(x[i] == dist(r5), "x[" << i << "]");
+  }
+  CHECK(r5 == r6);
+
+  // Frequent rejections.
+  uniform_int<uint32_t> dist2(0, 0x80000000U);
+  uint32_t y[1000];
+  dist2.generate(begin(y), end(y), r2);
+  for (int i = 0; i < 1000; i++) {
+    CHECK_MESSAGE(y[i] == dist2(r1), "y[" << i << "]");
+  }
+  CHECK(r1 == r2);
+
+  // Two words per result.
+  uniform_int<uint64_t> dist3(0, 10000000000ULL);
+  uint64_t z[1000];
+  dist3.generate(begin(z), end(z), r2);
+  for (int i = 0; i < 1000; i++) {
+    CHECK_MESSAGE(z[i] == dist3(r1), "z[" << i << "]");
+  }
+  CHECK(r1 == r2);
+}
+
+TEST_CASE("param") {
+  uniform_int<> dist1(1, 6);
+  uniform_int<> dist2;
+
+  CHECK(dist1.a() == 1);
+  CHECK(dist1.b() == 6);
+  CHECK(dist1.min() == 1);
+  CHECK(dist1.max() == 6);
+
+  CHECK(dist1 != dist2);
+  dist2.param(dist1.param());
+  CHECK(dist1 == dist2);
+
+  tinymt32 r1;
+  tinymt32 r2;
+  uniform_int<>::param_type p(100, 200);
+  CHECK(dist1(r1, p) == uniform_int<>(100, 200)(r2));
+}